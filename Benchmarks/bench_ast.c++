@@ -0,0 +1,201 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <iomanip>
+
+#include "../Lexico/Lexico.h"
+#include "../Sintatico/Sintatico.h"
+
+using namespace std;
+
+// Relatório de memória e tempo da AST: nós em arena (tipo enum, nomes internados,
+// filhos contíguos) contra a representação antiga (string tipo/valor, vector de filhos, new/delete).
+//
+//   g++ -std=c++17 -O2 Benchmarks/bench_ast.c++ -o bench_ast
+//   ./bench_ast [numero_de_funcoes]
+
+//================================================================================
+// CONTAGEM DE ALOCAÇÕES
+//================================================================================
+
+static size_t alocacoes = 0;
+static size_t bytesAlocados = 0;
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete" // new/delete abaixo usam malloc/free de propósito
+#endif
+
+void* operator new(size_t n) {
+    ++alocacoes;
+    bytesAlocados += n;
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+//================================================================================
+// REPRESENTAÇÃO ANTIGA (referência)
+//================================================================================
+
+struct ASTNodeLegado {
+    string tipo;
+    string valor;
+    vector<ASTNodeLegado*> filhos;
+    int linha;
+
+    ASTNodeLegado(string t, string v = "", int l = 0) : tipo(t), valor(v), linha(l) {}
+
+    ~ASTNodeLegado() {
+        for (ASTNodeLegado* filho : filhos) {
+            delete filho;
+        }
+    }
+};
+
+// Reconstrói a árvore como o parser antigo fazia: um new e duas strings por nó.
+ASTNodeLegado* clonarLegado(ASTNode* no, const TabelaDeNomes& nomes) {
+    ASTNodeLegado* novo = new ASTNodeLegado(nomeTipoNo(no->tipo), nomes.texto(no->valor), no->linha);
+    for (ASTNode* filho : no->filhos) novo->filhos.push_back(clonarLegado(filho, nomes));
+    return novo;
+}
+
+// Reconstrói a árvore na arena, pelo mesmo caminho do parser atual.
+ASTNode* clonarArena(ASTNode* no, const TabelaDeNomes& nomes, ArenaAST& destino, TabelaDeNomes& nomesDestino) {
+    ASTNode* novo = criarNo(destino, no->tipo, nomesDestino.internar(nomes.texto(no->valor)), no->linha);
+    for (ASTNode* filho : no->filhos) novo->filhos.adicionar(clonarArena(filho, nomes, destino, nomesDestino), destino);
+    return novo;
+}
+
+// Visitas no estilo do analisador semântico: cadeia de comparações de string contra switch.
+size_t visitarLegado(ASTNodeLegado* no) {
+    size_t n = 0;
+    if (no->tipo == "programa") n += 1;
+    else if (no->tipo == "bloco") n += 2;
+    else if (no->tipo == "declaracao_variaveis") n += 3;
+    else if (no->tipo == "funcao") n += 4;
+    else if (no->tipo == "atribuicao") n += 5;
+    else if (no->tipo == "identificador") n += 6;
+    for (ASTNodeLegado* filho : no->filhos) n += visitarLegado(filho);
+    return n;
+}
+
+size_t visitarArena(ASTNode* no) {
+    size_t n = 0;
+    switch (no->tipo) {
+        case TipoNo::PROGRAMA: n += 1; break;
+        case TipoNo::BLOCO: n += 2; break;
+        case TipoNo::DECLARACAO_VARIAVEIS: n += 3; break;
+        case TipoNo::FUNCAO: n += 4; break;
+        case TipoNo::ATRIBUICAO: n += 5; break;
+        case TipoNo::IDENTIFICADOR: n += 6; break;
+        default: break;
+    }
+    for (ASTNode* filho : no->filhos) n += visitarArena(filho);
+    return n;
+}
+
+size_t contarNos(ASTNode* no) {
+    size_t n = 1;
+    for (ASTNode* filho : no->filhos) n += contarNos(filho);
+    return n;
+}
+
+//================================================================================
+// ENTRADA E MEDIÇÃO
+//================================================================================
+
+string gerarPrograma(int funcoes) {
+    string fonte = "Program Bench;\nvar\n  m, y, total: integer;\n\n";
+    for (int i = 0; i < funcoes; ++i) {
+        string nome = "calcula" + to_string(i);
+        fonte += "function " + nome + "(n: integer): integer;\n";
+        fonte += "var a, b: integer;\n";
+        fonte += "begin\n";
+        fonte += "  a := n * 2 + 10 div 3;\n";
+        fonte += "  b := a - 1;\n";
+        fonte += "  while b > 0 do\n";
+        fonte += "    b := b - 1;\n";
+        fonte += "  if (n <= 1) and (a <> b) then\n";
+        fonte += "    " + nome + " := 1\n";
+        fonte += "  else\n";
+        fonte += "    " + nome + " := n * " + nome + "(n - 1);\n";
+        fonte += "end;\n\n";
+    }
+    fonte += "begin\n  read(m);\n  write(calcula0(m));\nend.\n";
+    return fonte;
+}
+
+double segundosDesde(chrono::steady_clock::time_point inicio) {
+    return chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+}
+
+struct Medida {
+    size_t bytes;
+    size_t alocs;
+    double construir;
+    double visitar;
+    double liberar;
+};
+
+void imprimirLinha(const string& nome, size_t nos, const Medida& m) {
+    cout << left << setw(10) << nome << setw(12) << m.bytes << setw(12) << fixed << setprecision(1)
+         << (double)m.bytes / nos << setw(12) << m.alocs << setprecision(2)
+         << setw(14) << m.construir * 1e3 << setw(12) << m.visitar * 1e3 << m.liberar * 1e3 << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int funcoes = argc > 1 ? atoi(argv[1]) : 20000;
+
+    AnalisadorSintatico parser(analisarLexico(gerarPrograma(funcoes)));
+    ASTNode* raiz = parser.programa();
+    if (!raiz) return 1;
+    size_t nos = contarNos(raiz);
+
+    // Representação antiga
+    Medida legado;
+    size_t alocsAntes = alocacoes, bytesAntes = bytesAlocados;
+    auto t = chrono::steady_clock::now();
+    ASTNodeLegado* raizLegado = clonarLegado(raiz, parser.nomes);
+    legado.construir = segundosDesde(t);
+    legado.alocs = alocacoes - alocsAntes;
+    legado.bytes = bytesAlocados - bytesAntes;
+    t = chrono::steady_clock::now();
+    size_t somaLegado = visitarLegado(raizLegado);
+    legado.visitar = segundosDesde(t);
+    t = chrono::steady_clock::now();
+    delete raizLegado;
+    legado.liberar = segundosDesde(t);
+
+    // Arena
+    Medida nova;
+    ArenaAST destino;
+    TabelaDeNomes nomesDestino;
+    alocsAntes = alocacoes;
+    bytesAntes = bytesAlocados;
+    t = chrono::steady_clock::now();
+    ASTNode* raizArena = clonarArena(raiz, parser.nomes, destino, nomesDestino);
+    nova.construir = segundosDesde(t);
+    nova.alocs = alocacoes - alocsAntes;
+    nova.bytes = bytesAlocados - bytesAntes; // Blocos da arena + tabela de nomes
+    t = chrono::steady_clock::now();
+    size_t somaArena = visitarArena(raizArena);
+    nova.visitar = segundosDesde(t);
+    t = chrono::steady_clock::now();
+    destino.limpar();
+    nova.liberar = segundosDesde(t);
+
+    cout << "Funcoes: " << funcoes << "  Nos: " << nos << "  Nomes internados: " << nomesDestino.tamanho()
+         << "  sizeof(ASTNode): " << sizeof(ASTNode) << " (antes: " << sizeof(ASTNodeLegado) << ")\n\n";
+    cout << left << setw(10) << "AST" << setw(12) << "bytes" << setw(12) << "bytes/no" << setw(12) << "alocacoes"
+         << setw(14) << "construir ms" << setw(12) << "visitar ms" << "liberar ms" << endl;
+    cout << string(82, '-') << endl;
+    imprimirLinha("antiga", nos, legado);
+    imprimirLinha("arena", nos, nova);
+    cout << "\nMemoria da arena: " << nova.bytes * 100.0 / legado.bytes << "% da representacao antiga"
+         << (somaLegado == somaArena ? "" : "  (ATENCAO: visitas divergentes)") << endl;
+    return 0;
+}
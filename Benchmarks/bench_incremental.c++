@@ -0,0 +1,155 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <cstdio>
+
+#include "../Compilador/Incremental.h"
+#include "../Compilador/Unidade.h"
+
+using namespace std;
+
+// Reanálise incremental (Compilador/Incremental.h) de um programa grande depois de pequenas
+// edições, comparada com a análise completa. Cada cenário parte do cache do programa original,
+// lê o cache do disco, analisa e grava o cache novo; os diagnósticos são conferidos com os da
+// análise completa do fonte editado.
+//
+//   g++ -std=c++17 -O2 Benchmarks/bench_incremental.c++ -o bench_incremental
+//   ./bench_incremental [linhas]      (padrão: 100000)
+
+const string CAMINHO_CACHE = "bench_incremental.cache";
+
+string gerarFuncao(int i) {
+    string nome = "calcula" + to_string(i);
+    string s = "function " + nome + "(n: integer): integer;\n";
+    s += "var a, b: integer;\n";
+    s += "begin\n";
+    s += "  a := n * 2 + 10 div 3;\n";
+    s += "  b := a - 1;\n";
+    s += "  while b > 0 do\n";
+    s += "    b := b - 1;\n";
+    s += "  if (n <= 1) and (a <> b) then\n";
+    s += "    " + nome + " := 1\n";
+    s += "  else\n";
+    s += "    " + nome + " := n * " + nome + "(n - 1);\n";
+    s += "end;\n\n";
+    return s;
+}
+
+string gerarPrograma(size_t linhas) {
+    string fonte = "Program Grande;\nvar\n  m, y, total: integer;\n\n";
+    int funcoes = (int)max<size_t>(1, linhas / 13);
+    for (int i = 0; i < funcoes; ++i) fonte += gerarFuncao(i);
+    fonte += "begin\n  read(m);\n  y := calcula0(m);\n  write(y)\nend.\n";
+    return fonte;
+}
+
+double agora() {
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool mesmosDiagnosticos(const vector<Diagnostico>& a, const vector<Diagnostico>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].mensagem != b[i].mensagem) return false;
+    }
+    return true;
+}
+
+void gravarArquivo(const string& caminho, const string& dados) {
+    ofstream saida(caminho, ios::binary);
+    saida.write(dados.data(), dados.size());
+}
+
+int main(int argc, char* argv[]) {
+    size_t linhasPedidas = argc > 1 ? stoul(argv[1]) : 100000;
+    string original = gerarPrograma(linhasPedidas);
+    size_t meio = original.find("function calcula" + to_string(linhasPedidas / 26) + "(");
+
+    // Análise completa: a referência de tempo.
+    double melhorCompleta = 1e9;
+    for (int rep = 0; rep < 3; ++rep) {
+        double t0 = agora();
+        compilarUnidade(original);
+        melhorCompleta = min(melhorCompleta, agora() - t0);
+    }
+
+    // Primeira execução: sem cache, analisa tudo e grava o cache.
+    double t0 = agora();
+    CacheIncremental cacheInicial;
+    AnaliseIncremental inicial;
+    inicial.analisar(original, cacheInicial);
+    salvarCache(CAMINHO_CACHE, cacheInicial);
+    double tempoInicial = agora() - t0;
+    string cacheOriginal;
+    lerArquivoInteiro(CAMINHO_CACHE, cacheOriginal);
+
+    cout << "Linhas: " << contarLinhas(original) << "  Bytes: " << original.size()
+         << "  Regioes: " << inicial.regioes() << "  Cache: " << cacheOriginal.size() / 1024 << " KB\n";
+    cout << fixed << setprecision(1)
+         << "Analise completa: " << melhorCompleta * 1e3 << " ms   primeira execucao (com gravacao do cache): "
+         << tempoInicial * 1e3 << " ms\n\n";
+
+    struct Cenario {
+        string nome;
+        string fonte;
+    };
+    vector<Cenario> cenarios;
+    cenarios.push_back({"sem mudancas", original});
+
+    string editado = original; // Uma linha do corpo de uma função do meio
+    size_t p = editado.find("b := a - 1", meio);
+    editado.replace(p, 10, "b := a - 2");
+    cenarios.push_back({"edita 1 linha", editado});
+
+    editado = original; // Uma linha nova: metade do arquivo muda de linha
+    p = editado.find("begin\n", meio) + 6;
+    editado.insert(p, "  a := n;\n");
+    cenarios.push_back({"insere 1 linha", editado});
+
+    editado = original; // Erro semântico em uma função do meio
+    p = editado.find("b := a - 1", meio);
+    editado.replace(p, 10, "b := a + x");
+    cenarios.push_back({"erro semantico", editado});
+
+    editado = original; // Erro sintático: cai na análise completa
+    p = editado.find("b := a - 1", meio);
+    editado.replace(p, 10, "b := a - (");
+    cenarios.push_back({"erro sintatico", editado});
+
+    editado = original; // Global nova: o ambiente de todas as regiões muda, mas nenhuma a usa
+    editado.replace(editado.find("total: integer;"), 15, "total, z: integer;");
+    cenarios.push_back({"global nova", editado});
+
+    cout << left << setw(17) << "cenario" << setw(10) << "ms" << setw(10) << "x compl." << setw(11) << "ler cache"
+         << setw(10) << "analisar" << setw(10) << "gravar" << setw(12) << "analisadas" << setw(12) << "conferidas"
+         << setw(14) << "bytes relidos" << "diagnosticos iguais" << endl;
+    cout << string(125, '-') << endl;
+
+    for (const Cenario& c : cenarios) {
+        gravarArquivo(CAMINHO_CACHE, cacheOriginal);
+
+        double inicio = agora();
+        CacheIncremental cache;
+        lerCache(CAMINHO_CACHE, cache);
+        double lido = agora();
+        AnaliseIncremental analise;
+        analise.analisar(c.fonte, cache);
+        double analisado = agora();
+        if (analise.cacheAlterado) salvarCache(CAMINHO_CACHE, cache);
+        double fim = agora();
+
+        bool iguais = mesmosDiagnosticos(analise.erros, compilarUnidade(c.fonte).erros);
+        cout << left << setw(17) << c.nome << setprecision(2) << setw(10) << (fim - inicio) * 1e3
+             << setprecision(1) << setw(10) << melhorCompleta / (fim - inicio)
+             << setprecision(2) << setw(11) << (lido - inicio) * 1e3 << setw(10) << (analisado - lido) * 1e3
+             << setw(10) << (fim - analisado) * 1e3 << setw(12) << analise.regioesAnalisadas
+             << setw(12) << analise.regioesConferidas << setw(14) << analise.bytesRelidos
+             << (iguais ? "sim" : "nao") << (analise.completa ? "  (analise completa)" : "") << endl;
+    }
+
+    remove(CAMINHO_CACHE.c_str());
+    return 0;
+}
@@ -0,0 +1,195 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <unordered_set>
+#include <cctype>
+#include <iomanip>
+
+#include "../Lexico/Lexico.h"
+
+using namespace std;
+
+// Benchmark de vazão do analisador léxico (MB/s).
+// Compara o autômato de Lexico.h com o scanner antigo, linha a linha, em entradas geradas.
+//
+//   g++ -std=c++17 -O2 Benchmarks/bench_lexico.c++ -o bench_lexico
+//   ./bench_lexico [tamanho_em_MB ...]
+
+//================================================================================
+// SCANNER ANTIGO (referência): getline + isSymbol + unordered_set por token
+//================================================================================
+
+struct TokenLegado {
+    string lexema;
+    string tipo;
+    int linha;
+};
+
+bool isSymbolLegado(char c) {
+    string symbols = "+-*/:=<>{}();.,[]^";
+    return symbols.find(c) != string::npos;
+}
+
+string getTipoSimboloLegado(const string& simbolo) {
+    unordered_set<string> simbolosCompostos = { ":=", "<=", ">=", "<>", "==", ".." };
+    return simbolosCompostos.count(simbolo) ? "Simbolo composto" : "Simbolo simples";
+}
+
+vector<TokenLegado> analisarLexicoLegado(istream& arquivo) {
+    unordered_set<string> palavrasReservadasLegado = {
+        "program", "Program", "var", "function", "begin", "end", "read", "write",
+        "if", "then", "else", "integer", "boolean", "double", "while",
+        "procedure", "goto", "for", "do", "not", "and", "or", "to", "downto",
+        "label", "type", "array", "of", "real", "div", "mod"
+    };
+    auto classificar = [&](const string& buffer) -> string {
+        if (palavrasReservadasLegado.count(buffer)) return "Palavra reservada";
+        if (all_of(buffer.begin(), buffer.end(), ::isdigit)) return "Numero";
+        if (isalpha(buffer[0])) return "Identificador";
+        return "";
+    };
+
+    vector<TokenLegado> tokens;
+    string linha;
+    int numeroLinha = 0;
+    while (getline(arquivo, linha)) {
+        numeroLinha++;
+        string token_buffer;
+        linha += ' ';
+        for (size_t i = 0; i < linha.size(); ++i) {
+            char c = linha[i];
+            if (c == '{') {
+                while (i < linha.size() && linha[i] != '}') ++i;
+                continue;
+            }
+            if (c == '(' && i + 1 < linha.size() && linha[i + 1] == '*') {
+                i += 2;
+                while (i < linha.size()) {
+                    if (linha[i] == '*' && i + 1 < linha.size() && linha[i + 1] == ')') { i++; break; }
+                    i++;
+                }
+                continue;
+            }
+            if (c == '/' && i + 1 < linha.size() && linha[i + 1] == '/') break;
+            if (c == '\'') {
+                if (!token_buffer.empty()) {
+                    string tipo = classificar(token_buffer);
+                    if (!tipo.empty()) tokens.push_back({token_buffer, tipo, numeroLinha});
+                    token_buffer.clear();
+                }
+                i++;
+                while (i < linha.size() && linha[i] != '\'') i++;
+                continue;
+            }
+            if (isspace(c)) {
+                if (!token_buffer.empty()) {
+                    string tipo = classificar(token_buffer);
+                    if (!tipo.empty()) tokens.push_back({token_buffer, tipo, numeroLinha});
+                    token_buffer.clear();
+                }
+            } else if (isSymbolLegado(c)) {
+                if (!token_buffer.empty()) {
+                    string tipo = classificar(token_buffer);
+                    if (!tipo.empty()) tokens.push_back({token_buffer, tipo, numeroLinha});
+                    token_buffer.clear();
+                }
+                string simbolo_str(1, c);
+                if (i + 1 < linha.size()) {
+                    string possivel_composto = string(1, c) + linha[i + 1];
+                    unordered_set<string> simbolosCompostosDuplos = { ":=", "<=", ">=", "<>", "==", ".." };
+                    if (simbolosCompostosDuplos.count(possivel_composto)) {
+                        simbolo_str = possivel_composto;
+                        ++i;
+                    }
+                }
+                tokens.push_back({simbolo_str, getTipoSimboloLegado(simbolo_str), numeroLinha});
+            } else {
+                token_buffer += c;
+            }
+        }
+    }
+    return tokens;
+}
+
+//================================================================================
+// GERADOR DE ENTRADA
+//================================================================================
+
+// Gera um programa com funções repetidas até atingir aproximadamente 'bytes'.
+// Só usa construções de uma linha, para que os dois scanners produzam os mesmos tokens.
+string gerarPrograma(size_t bytes) {
+    string fonte = "Program Bench;\nvar\n  m, y, total: integer;\n\n";
+    int i = 0;
+    while (fonte.size() < bytes) {
+        string nome = "calcula" + to_string(i++);
+        fonte += "{ funcao gerada numero " + to_string(i) + " }\n";
+        fonte += "function " + nome + "(n: integer): integer;\n";
+        fonte += "var a, b: integer;\n";
+        fonte += "begin\n";
+        fonte += "  a := n * 2 + 10 div 3; (* comentario *)\n";
+        fonte += "  b := a - 1;\n";
+        fonte += "  if (n <= 1) and (a <> b) then\n";
+        fonte += "    " + nome + " := 1\n";
+        fonte += "  else\n";
+        fonte += "    " + nome + " := n * " + nome + "(n - 1); // recursao\n";
+        fonte += "end;\n\n";
+    }
+    fonte += "begin\n  read(m);\n  write(calcula0(m));\nend.\n";
+    return fonte;
+}
+
+//================================================================================
+// MEDIÇÃO
+//================================================================================
+
+template <typename F>
+double melhorTempo(int repeticoes, F&& f) {
+    double melhor = 1e300;
+    for (int r = 0; r < repeticoes; ++r) {
+        auto inicio = chrono::steady_clock::now();
+        f();
+        chrono::duration<double> d = chrono::steady_clock::now() - inicio;
+        melhor = min(melhor, d.count());
+    }
+    return melhor;
+}
+
+int main(int argc, char* argv[]) {
+    vector<size_t> tamanhosMB = {4, 16, 64};
+    if (argc > 1) {
+        tamanhosMB.clear();
+        for (int i = 1; i < argc; ++i) tamanhosMB.push_back(stoul(argv[i]));
+    }
+
+    cout << left << setw(10) << "MB" << setw(12) << "tokens"
+         << setw(16) << "antigo (MB/s)" << setw(16) << "DFA (MB/s)" << setw(10) << "ganho" << "iguais" << endl;
+    cout << string(72, '-') << endl;
+
+    for (size_t mb : tamanhosMB) {
+        string fonte = gerarPrograma(mb << 20);
+        double tamanho = fonte.size() / (1024.0 * 1024.0);
+
+        vector<TokenLegado> legado;
+        double tLegado = melhorTempo(3, [&] {
+            istringstream entrada(fonte);
+            legado = analisarLexicoLegado(entrada);
+        });
+
+        vector<Token> novos;
+        double tNovo = melhorTempo(3, [&] { novos = analisarLexico(fonte); });
+
+        bool iguais = legado.size() == novos.size();
+        for (size_t i = 0; iguais && i < novos.size(); ++i) {
+            iguais = legado[i].lexema == novos[i].lexema && legado[i].tipo == novos[i].tipo
+                     && legado[i].linha == novos[i].linha;
+        }
+
+        cout << left << setw(10) << fixed << setprecision(1) << tamanho << setw(12) << novos.size()
+             << setw(16) << tamanho / tLegado << setw(16) << tamanho / tNovo
+             << setw(10) << setprecision(2) << tLegado / tNovo << (iguais ? "sim" : "nao") << endl;
+    }
+    return 0;
+}
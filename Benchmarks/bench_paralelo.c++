@@ -0,0 +1,87 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+#include "../Compilador/Unidade.h"
+#include "../Compilador/PoolDeTrabalho.h"
+
+using namespace std;
+
+// Vazão do driver paralelo (arquivos/s e linhas/s) com 1, 2, 4, ... threads.
+// As unidades são geradas em memória com tamanhos variados (para exercitar o roubo de tarefas)
+// e os diagnósticos de todas as execuções são comparados com os da execução com 1 thread.
+//
+//   g++ -std=c++17 -O2 -pthread Benchmarks/bench_paralelo.c++ -o bench_paralelo
+//   ./bench_paralelo [numero_de_unidades]
+
+// Gera uma unidade com 'funcoes' funções; unidades múltiplas de 7 têm um erro sintático e
+// as múltiplas de 11 um erro semântico.
+string gerarUnidade(int id, int funcoes) {
+    string fonte = "Program U" + to_string(id) + ";\nvar\n  m, y, total: integer;\n\n";
+    for (int i = 0; i < funcoes; ++i) {
+        string nome = "calcula" + to_string(i);
+        fonte += "function " + nome + "(n: integer): integer;\n";
+        fonte += "var a, b: integer;\n";
+        fonte += "begin\n";
+        fonte += "  a := n * 2 + 10 div 3;\n";
+        fonte += "  b := a - 1;\n";
+        fonte += "  while b > 0 do\n";
+        fonte += "    b := b - 1;\n";
+        fonte += "  if (n <= 1) and (a <> b) then\n";
+        fonte += "    " + nome + " := 1\n";
+        fonte += "  else\n";
+        fonte += "    " + nome + " := n * " + nome + "(n - 1);\n";
+        fonte += "end;\n\n";
+    }
+    fonte += "begin\n  read(m);\n";
+    if (id % 7 == 0) fonte += "  y := (m + 1;\n";
+    if (id % 11 == 0) fonte += "  naoDeclarada := m;\n";
+    fonte += "  write(calcula0(m));\nend.\n";
+    return fonte;
+}
+
+int main(int argc, char* argv[]) {
+    size_t unidades = argc > 1 ? stoul(argv[1]) : 2000;
+
+    vector<string> fontes;
+    size_t linhas = 0;
+    for (size_t i = 0; i < unidades; ++i) {
+        fontes.push_back(gerarUnidade((int)i, 1 + (int)((i * 2654435761u) % 40))); // 1 a 40 funções
+        linhas += contarLinhas(fontes.back());
+    }
+
+    size_t nucleos = max(1u, thread::hardware_concurrency());
+    cout << "Unidades: " << unidades << "  Linhas: " << linhas << "  Nucleos: " << nucleos << "\n\n";
+    cout << left << setw(10) << "threads" << setw(12) << "ms" << setw(14) << "arquivos/s"
+         << setw(14) << "linhas/s" << setw(10) << "roubos" << "diagnosticos iguais" << endl;
+    cout << string(78, '-') << endl;
+
+    vector<vector<Diagnostico>> referencia;
+    for (size_t threads = 1; threads <= max<size_t>(nucleos, 4); threads *= 2) {
+        vector<ResultadoUnidade> resultados(unidades);
+        PoolDeTrabalho pool(threads);
+        auto inicio = chrono::steady_clock::now();
+        pool.executar(unidades, [&](size_t i) { resultados[i] = compilarUnidade(fontes[i]); });
+        double s = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+        bool iguais = true;
+        if (referencia.empty()) {
+            for (ResultadoUnidade& r : resultados) referencia.push_back(r.erros);
+        } else {
+            for (size_t i = 0; i < unidades && iguais; ++i) {
+                iguais = resultados[i].erros.size() == referencia[i].size();
+                for (size_t k = 0; iguais && k < referencia[i].size(); ++k) {
+                    iguais = resultados[i].erros[k].mensagem == referencia[i][k].mensagem;
+                }
+            }
+        }
+
+        cout << left << setw(10) << threads << fixed << setprecision(1) << setw(12) << s * 1e3
+             << setprecision(0) << setw(14) << unidades / s << setw(14) << linhas / s
+             << setw(10) << pool.tarefasRoubadas() << (iguais ? "sim" : "nao") << endl;
+    }
+    return 0;
+}
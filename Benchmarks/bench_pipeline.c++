@@ -0,0 +1,64 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <iomanip>
+
+#include "../Compilador/Estatisticas.h"
+#include "../Ferramentas/GeradorPascal.h"
+
+using namespace std;
+
+// Compilação completa (léxico, sintático e semântico) de programas sintéticos de 1 mil, 100 mil
+// e 1 milhão de linhas (Ferramentas/GeradorPascal.h), com o tempo e as alocações de cada fase.
+// Com --json, imprime as medidas de cada tamanho no formato do Compilador --stats. As alocações
+// só são contadas com Compilador/ContadorAlocacoes.c++ na linha de compilação ('-' sem ele).
+//
+//   g++ -std=c++17 -O2 Benchmarks/bench_pipeline.c++ Compilador/ContadorAlocacoes.c++ -o bench_pipeline
+//   ./bench_pipeline [--json] [linhas ...]      (padrão: 1000 100000 1000000)
+
+int main(int argc, char* argv[]) {
+    bool json = false;
+    vector<size_t> tamanhos;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--json") json = true;
+        else tamanhos.push_back(stoul(arg));
+    }
+    if (tamanhos.empty()) tamanhos = {1000, 100000, 1000000};
+
+    if (!json) {
+        cout << left << setw(10) << "linhas" << setw(10) << "MB" << setw(11) << "lexico ms" << setw(13) << "sintatico ms"
+             << setw(14) << "semantico ms" << setw(10) << "total ms" << setw(12) << "M tokens/s" << setw(13) << "M linhas/s"
+             << setw(11) << "nos AST" << setw(10) << "MB AST" << setw(12) << "alocacoes" << setw(11) << "simbolos"
+             << setw(11) << "escopos" << "erros" << endl;
+        cout << string(158, '-') << endl;
+    }
+
+    for (size_t linhas : tamanhos) {
+        string fonte = gerarProgramaPascal(linhas);
+
+        // A melhor de 3 execuções (1 para o maior programa).
+        EstatisticasCompilacao melhor;
+        int repeticoes = linhas >= 1000000 ? 1 : 3;
+        for (int rep = 0; rep < repeticoes; ++rep) {
+            EstatisticasCompilacao e = medirCompilacao(fonte);
+            if (rep == 0 || e.total().segundos < melhor.total().segundos) melhor = e;
+        }
+
+        if (json) {
+            escreverEstatisticasJSON(cout, melhor, "sintetico_" + to_string(linhas));
+            continue;
+        }
+        MedidaFase total = melhor.total();
+        cout << left << setw(10) << melhor.linhas << fixed << setprecision(1) << setw(10) << melhor.bytes / 1e6
+             << setprecision(2) << setw(11) << melhor.lexico.segundos * 1e3 << setw(13) << melhor.sintatico.segundos * 1e3
+             << setw(14) << melhor.semantico.segundos * 1e3 << setw(10) << total.segundos * 1e3
+             << setw(12) << porSegundo(melhor.tokens, total.segundos) / 1e6
+             << setw(13) << porSegundo(melhor.linhas, total.segundos) / 1e6
+             << setw(11) << melhor.nosAST << setw(10) << melhor.bytesAST / 1e6
+             << setw(12) << (contadorAlocacoes.ativo ? to_string(total.alocacoes) : "-")
+             << setw(11) << melhor.picoSimbolos << setw(11) << melhor.profundidadeMaxima
+             << melhor.errosSintaticos + melhor.errosSemanticos << endl;
+    }
+    return 0;
+}
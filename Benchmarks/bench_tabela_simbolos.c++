@@ -0,0 +1,152 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <stack>
+#include <chrono>
+#include <stdexcept>
+#include <iomanip>
+
+#include "../Semantico/Semantico.h"
+
+using namespace std;
+
+// Microbenchmark da tabela de símbolos: varia a quantidade de identificadores e a
+// profundidade de escopos e mede o custo por busca e por entrar/sair de escopo.
+// A tabela antiga (pilha de map copiada a cada busca) serve de referência.
+//
+//   g++ -std=c++17 -O2 Benchmarks/bench_tabela_simbolos.c++ -o bench_tabela_simbolos
+//   ./bench_tabela_simbolos
+
+//================================================================================
+// TABELA ANTIGA (referência)
+//================================================================================
+
+struct SimboloLegado {
+    string nome;
+    string categoria;
+    TipoDado tipoDado;
+    int linhaDeclaracao;
+};
+
+class TabelaDeSimbolosLegado {
+private:
+    stack<map<string, SimboloLegado>> pilhaDeEscopos;
+
+public:
+    TabelaDeSimbolosLegado() { entrarEscopo(); }
+    void entrarEscopo() { pilhaDeEscopos.push({}); }
+    void sairEscopo() { if (!pilhaDeEscopos.empty()) pilhaDeEscopos.pop(); }
+
+    void adicionarSimbolo(const SimboloLegado& s) {
+        if (pilhaDeEscopos.top().count(s.nome)) throw runtime_error("duplicado");
+        pilhaDeEscopos.top()[s.nome] = s;
+    }
+
+    SimboloLegado buscarSimbolo(const string& nome, int) {
+        stack<map<string, SimboloLegado>> temp = pilhaDeEscopos;
+        while (!temp.empty()) {
+            if (temp.top().count(nome)) return temp.top().at(nome);
+            temp.pop();
+        }
+        throw runtime_error("nao declarado");
+    }
+};
+
+//================================================================================
+// MEDIÇÃO
+//================================================================================
+
+double segundosDesde(chrono::steady_clock::time_point inicio) {
+    return chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+}
+
+struct Resultado {
+    double nsPorBusca;
+    double nsPorEscopo; // Entrar, declarar o escopo inteiro e sair
+};
+
+// Os nomes de 'textos' são divididos entre 'profundidade' escopos aninhados; as buscas
+// são feitas do escopo mais interno, percorrendo todos os nomes.
+Resultado medirNova(const vector<string>& textos, int profundidade, size_t buscas) {
+    TabelaDeNomes nomes;
+    vector<Nome> ids;
+    for (const string& t : textos) ids.push_back(nomes.internar(t));
+
+    TabelaDeSimbolos tabela(nomes);
+    size_t porEscopo = ids.size() / profundidade;
+    auto t = chrono::steady_clock::now();
+    for (int d = 0; d < profundidade; ++d) {
+        tabela.entrarEscopo();
+        for (size_t i = d * porEscopo; i < (d + 1) * porEscopo; ++i) {
+            tabela.adicionarSimbolo({ids[i], Categoria::VARIAVEL, TipoDado::INTEIRO, 1});
+        }
+    }
+    double tDeclarar = segundosDesde(t);
+
+    size_t soma = 0;
+    t = chrono::steady_clock::now();
+    for (size_t b = 0; b < buscas; ++b) {
+        soma += tabela.buscarSimbolo(ids[(b * 7919) % (porEscopo * profundidade)])->linhaDeclaracao;
+    }
+    double tBuscar = segundosDesde(t);
+
+    t = chrono::steady_clock::now();
+    for (int d = 0; d < profundidade; ++d) tabela.sairEscopo();
+    double tSair = segundosDesde(t);
+
+    if (soma != buscas) cerr << "resultado inesperado\n";
+    return {tBuscar * 1e9 / buscas, (tDeclarar + tSair) * 1e9 / profundidade};
+}
+
+Resultado medirLegado(const vector<string>& textos, int profundidade, size_t buscas) {
+    TabelaDeSimbolosLegado tabela;
+    size_t porEscopo = textos.size() / profundidade;
+    auto t = chrono::steady_clock::now();
+    for (int d = 0; d < profundidade; ++d) {
+        tabela.entrarEscopo();
+        for (size_t i = d * porEscopo; i < (d + 1) * porEscopo; ++i) {
+            tabela.adicionarSimbolo({textos[i], "variavel", TipoDado::INTEIRO, 1});
+        }
+    }
+    double tDeclarar = segundosDesde(t);
+
+    size_t soma = 0;
+    t = chrono::steady_clock::now();
+    for (size_t b = 0; b < buscas; ++b) {
+        soma += tabela.buscarSimbolo(textos[(b * 7919) % (porEscopo * profundidade)], 1).linhaDeclaracao;
+    }
+    double tBuscar = segundosDesde(t);
+
+    t = chrono::steady_clock::now();
+    for (int d = 0; d < profundidade; ++d) tabela.sairEscopo();
+    double tSair = segundosDesde(t);
+
+    if (soma != buscas) cerr << "resultado inesperado\n";
+    return {tBuscar * 1e9 / buscas, (tDeclarar + tSair) * 1e9 / profundidade};
+}
+
+int main() {
+    cout << left << setw(14) << "simbolos" << setw(12) << "escopos"
+         << setw(18) << "antiga ns/busca" << setw(16) << "nova ns/busca" << setw(12) << "ganho"
+         << setw(20) << "antiga ns/escopo" << "nova ns/escopo" << endl;
+    cout << string(106, '-') << endl;
+
+    for (size_t n : {1000, 10000, 100000}) {
+        vector<string> textos;
+        for (size_t i = 0; i < n; ++i) textos.push_back("var" + to_string(i));
+
+        for (int profundidade : {1, 8, 64}) {
+            // A tabela antiga copia todos os escopos a cada busca: limita as buscas para caber no tempo.
+            size_t buscasLegado = max<size_t>(20, 2000000 / n);
+            Resultado antiga = medirLegado(textos, profundidade, buscasLegado);
+            Resultado nova = medirNova(textos, profundidade, 2000000);
+
+            cout << left << setw(14) << n << setw(12) << profundidade << fixed << setprecision(1)
+                 << setw(18) << antiga.nsPorBusca << setw(16) << nova.nsPorBusca
+                 << setw(12) << setprecision(0) << antiga.nsPorBusca / nova.nsPorBusca
+                 << setw(20) << antiga.nsPorEscopo << nova.nsPorEscopo << endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../Lexico/Lexico.h"
+#include "../Sintatico/Sintatico.h"
+#include "../Semantico/Semantico.h"
+#include "Incremental.h"
+#include "Estatisticas.h"
+#include "../Maquina/GeradorBytecode.h"
+#include "../Maquina/MaquinaVirtual.h"
+
+using namespace std;
+
+// Compilador completo em uma única passada: os tokens do analisador léxico vão
+// direto para o parser em memória, sem passar pelo arquivo intermediário saida.txt.
+//
+// Uso: Compilador [arquivo_fonte] [--tokens arquivo_saida] [--ast] [--incremental arquivo_cache]
+//                  [--bytecode] [--executar] [--stats]
+//   --tokens       grava a tabela de tokens (formato de saida.txt) para depuração
+//   --ast          imprime a árvore sintática, com os tipos das expressões, após a análise
+//   --incremental  reanalisa só as regiões que mudaram desde a execução que gravou o cache
+//                  (ver Incremental.h); o cache é criado na primeira execução
+//   --bytecode     lista o bytecode gerado (ver Maquina/Bytecode.h)
+//   --executar     executa o programa na máquina virtual (lê da entrada padrão, escreve na saída)
+//   --stats        em vez do relatório normal, imprime em JSON o tempo e as alocações de cada fase,
+//                  o tamanho da AST e da tabela de símbolos (ver Estatisticas.h); as alocações só
+//                  são contadas se o programa for compilado junto com ContadorAlocacoes.c++
+//
+// O bytecode só é gerado se as análises terminarem sem erros.
+
+// Imprime o resultado das duas análises como na compilação normal.
+void imprimirResultado(const vector<Diagnostico>& sintaticos, const vector<Diagnostico>& semanticos, bool houveSemantica) {
+    if (sintaticos.empty()) {
+        cout << "\nAnalise sintatica concluida com sucesso.\n";
+    } else {
+        imprimirDiagnosticos(cout, sintaticos);
+        cout << "\nAnalise sintatica concluida com " << sintaticos.size() << " erro(s).\n";
+    }
+    if (!houveSemantica) return;
+    if (semanticos.empty()) {
+        cout << "\nAnalise semantica concluida com sucesso." << endl;
+    } else {
+        cout << "\n";
+        imprimirDiagnosticos(cout, semanticos);
+    }
+}
+
+// Gera o bytecode da árvore já analisada e, se pedido, lista e executa.
+int gerarEExecutar(ASTNode* raiz, const TabelaDeNomes& nomes, bool mostrarBytecode, bool executar) {
+    ProgramaBytecode programa;
+    GeradorBytecode gerador(nomes);
+    if (!gerador.gerar(raiz, programa)) {
+        cout << "\n";
+        imprimirDiagnosticos(cout, gerador.erros);
+        return 1;
+    }
+    if (mostrarBytecode) {
+        cout << "\n";
+        imprimirBytecode(cout, programa);
+    }
+    if (!executar) return 0;
+
+    cout << "\nExecucao:\n";
+    MaquinaVirtual maquina(programa, cin, cout);
+    ResultadoExecucao resultado = maquina.executar();
+    if (!resultado.ok) {
+        cout << resultado.erro << endl;
+        return 1;
+    }
+    return 0;
+}
+
+// Compilação com o cache de regiões. A saída é a mesma da compilação normal, seguida de
+// quantas regiões precisaram ser refeitas.
+int compilarIncremental(const string& fonte, const string& caminhoCache, bool mostrarAST, bool mostrarBytecode, bool executar) {
+    CacheIncremental cache;
+    lerCache(caminhoCache, cache); // Sem cache (ou com um cache inválido) a análise é completa.
+
+    AnaliseIncremental analise;
+    analise.analisar(fonte, cache);
+    const vector<Diagnostico>& sintaticos = analise.parser.diagnosticos;
+    if (analise.completa && analise.parser.tokens.empty()) {
+        cout << "Nenhum token foi encontrado no arquivo fonte.\n";
+        return 1;
+    }
+
+    bool houveSemantica = sintaticos.empty() || analise.arvore(); // Com erros sintáticos, só se houve árvore
+    vector<Diagnostico> semanticos(analise.erros.begin() + sintaticos.size(), analise.erros.end());
+    imprimirResultado(sintaticos, semanticos, houveSemantica);
+    if (mostrarAST) analise.parser.imprimirAST(analise.arvore());
+
+    cout << "\nIncremental: " << analise.regioesAnalisadas << " de " << analise.regioes() << " regiao(oes) analisada(s), "
+         << analise.regioesConferidas << " conferida(s), " << analise.bytesRelidos << " bytes relidos"
+         << (analise.completa ? " (analise completa)" : "") << ".\n";
+    if (analise.cacheAlterado && !salvarCache(caminhoCache, cache)) {
+        cout << "Erro ao gravar o cache: " << caminhoCache << endl;
+    }
+    if (!analise.erros.empty()) return 1;
+    if (mostrarBytecode || executar) return gerarEExecutar(analise.arvore(), analise.parser.nomes, mostrarBytecode, executar);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    string caminhoFonte = "C:\\Compiladores\\teste.txt"; // Entrada padrão
+    string caminhoTokens;                                 // Vazio: não grava saida.txt
+    string caminhoCache;                                  // Vazio: compilação normal
+    bool mostrarAST = false;
+    bool mostrarBytecode = false;
+    bool executar = false;
+    bool estatisticas = false;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--tokens" && i + 1 < argc) {
+            caminhoTokens = argv[++i];
+        } else if (arg == "--ast") {
+            mostrarAST = true;
+        } else if (arg == "--bytecode") {
+            mostrarBytecode = true;
+        } else if (arg == "--executar") {
+            executar = true;
+        } else if (arg == "--stats") {
+            estatisticas = true;
+        } else if (arg == "--incremental" && i + 1 < argc) {
+            caminhoCache = argv[++i];
+        } else {
+            caminhoFonte = arg;
+        }
+    }
+
+    // --- FASE 1: Análise Léxica ---
+    string fonte; // O arquivo inteiro fica em um único buffer.
+    if (!lerArquivoInteiro(caminhoFonte, fonte)) {
+        cout << "Erro ao abrir o arquivo. Verifique o caminho: " << caminhoFonte << endl;
+        return 1;
+    }
+    if (estatisticas) {
+        EstatisticasCompilacao e = medirCompilacao(fonte);
+        escreverEstatisticasJSON(cout, e, caminhoFonte);
+        return e.errosSintaticos + e.errosSemanticos == 0 ? 0 : 1;
+    }
+    vector<Token> lidos;
+    if (caminhoCache.empty() || !caminhoTokens.empty()) lidos = analisarLexico(fonte);
+
+    if (!caminhoTokens.empty()) { // Dump opcional da tabela de tokens
+        ofstream saida(caminhoTokens);
+        if (!saida.is_open()) {
+            cout << "Erro ao criar o arquivo de saida: " << caminhoTokens << endl;
+            return 1;
+        }
+        imprimirTabelaTokens(saida, lidos, false);
+    }
+    if (!caminhoCache.empty()) return compilarIncremental(fonte, caminhoCache, mostrarAST, mostrarBytecode, executar);
+
+    AnalisadorSintatico parser(move(lidos));
+    if (parser.tokens.empty()) {
+        cout << "Nenhum token foi encontrado no arquivo fonte.\n";
+        return 1;
+    }
+
+    // --- FASE 2: Análise Sintática ---
+    // O parser se recupera dos erros: todos ficam em 'diagnosticos' e a árvore parcial segue adiante.
+    ASTNode* raiz = parser.programa();
+
+    // --- FASE 3: Análise Semântica ---
+    AnalisadorSemantico analisador(parser.nomes);
+    if (raiz) analisador.verificar(raiz);
+    imprimirResultado(parser.diagnosticos, analisador.erros, raiz != nullptr);
+    bool semErros = parser.diagnosticos.empty() && analisador.erros.empty();
+    if (mostrarAST) parser.imprimirAST(raiz); // Depois da fase 3, já com os tipos calculados.
+
+    // --- FASE 4: Geração de código e execução (opcionais) ---
+    if (semErros && (mostrarBytecode || executar)) return gerarEExecutar(raiz, parser.nomes, mostrarBytecode, executar);
+
+    // A AST é liberada de uma vez junto com o parser.
+    return semErros ? 0 : 1;
+}
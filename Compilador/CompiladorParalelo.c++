@@ -0,0 +1,103 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+
+#include "Unidade.h"
+#include "PoolDeTrabalho.h"
+
+using namespace std;
+
+// Compila várias unidades em paralelo: cada arquivo passa por léxico -> sintático -> semântico
+// em uma thread do pool (com roubo de tarefas). Os diagnósticos são impressos na ordem dos
+// arquivos de entrada, então a saída padrão é a mesma com qualquer número de threads. O
+// relatório de vazão (arquivos/s e linhas/s) vai para a saída de erro.
+//
+// Uso: CompiladorParalelo [-j threads] [--lista arquivo_com_caminhos] arquivo1 arquivo2 ...
+//   -j       número de threads (padrão: todos os núcleos)
+//   --lista  lê os caminhos das unidades de um arquivo, um por linha
+int main(int argc, char* argv[]) {
+    const char* uso = "Uso: CompiladorParalelo [-j threads] [--lista arquivo] arquivo1 arquivo2 ...\n";
+    size_t numThreads = 0;
+    vector<string> caminhos;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-j") {
+            // O valor precisa existir e ser um número (0 usa todos os núcleos).
+            string valor = i + 1 < argc ? argv[++i] : "";
+            if (valor.empty() || valor.size() > 6 || valor.find_first_not_of("0123456789") != string::npos) {
+                cout << "Numero de threads invalido: '" << valor << "'\n" << uso;
+                return 1;
+            }
+            numThreads = stoul(valor);
+        } else if (arg == "--lista" && i + 1 < argc) {
+            ifstream lista(argv[++i]);
+            if (!lista.is_open()) {
+                cout << "Erro ao abrir a lista de arquivos: " << argv[i] << endl;
+                return 1;
+            }
+            string linha;
+            while (getline(lista, linha)) {
+                if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+                if (!linha.empty()) caminhos.push_back(linha);
+            }
+        } else {
+            caminhos.push_back(arg);
+        }
+    }
+    if (caminhos.empty()) {
+        cout << uso;
+        return 1;
+    }
+
+    vector<ResultadoUnidade> resultados(caminhos.size()); // Um por unidade, na ordem de entrada
+    PoolDeTrabalho pool(numThreads);
+
+    auto inicio = chrono::steady_clock::now();
+    pool.executar(caminhos.size(), [&](size_t i) {
+        // Nenhuma exceção sai da tarefa: uma unidade com problema vira um diagnóstico dela e as
+        // outras continuam sendo compiladas.
+        try {
+            string fonte;
+            if (!lerArquivoInteiro(caminhos[i], fonte)) {
+                resultados[i].aberto = false;
+                return;
+            }
+            resultados[i] = compilarUnidade(fonte);
+        } catch (const exception& e) {
+            resultados[i] = ResultadoUnidade{};
+            resultados[i].erros.push_back({-1, string("Erro interno ao compilar a unidade: ") + e.what()});
+        } catch (...) {
+            resultados[i] = ResultadoUnidade{};
+            resultados[i].erros.push_back({-1, "Erro interno ao compilar a unidade."});
+        }
+    });
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+    // Diagnósticos em ordem determinística: arquivo por arquivo, na ordem de entrada.
+    size_t linhas = 0, tokens = 0, erros = 0, comErros = 0;
+    for (size_t i = 0; i < caminhos.size(); ++i) {
+        const ResultadoUnidade& r = resultados[i];
+        linhas += r.linhas;
+        tokens += r.tokens;
+        if (!r.aberto) {
+            cout << caminhos[i] << ": Erro ao abrir o arquivo.\n";
+            ++comErros;
+            continue;
+        }
+        for (const Diagnostico& d : r.erros) cout << caminhos[i] << ": " << d.mensagem << "\n";
+        erros += r.erros.size();
+        if (!r.erros.empty()) ++comErros;
+    }
+    cout << caminhos.size() << " arquivo(s), " << comErros << " com erros, " << erros << " erro(s)." << endl;
+
+    cerr << fixed << setprecision(1)
+         << "Threads: " << pool.threads() << "  tarefas roubadas: " << pool.tarefasRoubadas() << "\n"
+         << "Tempo: " << segundos * 1e3 << " ms  (" << linhas << " linhas, " << tokens << " tokens)\n"
+         << "Vazao: " << caminhos.size() / segundos << " arquivos/s, " << linhas / segundos << " linhas/s" << endl;
+
+    return comErros ? 1 : 0;
+}
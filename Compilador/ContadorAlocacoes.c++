@@ -0,0 +1,121 @@
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#include "ContadorAlocacoes.h"
+
+using namespace std;
+
+// Substitui as funções de alocação globais por versões que contam em contadorAlocacoes (ver
+// ContadorAlocacoes.h). Só entra nos programas que medem alocações:
+//
+//   g++ -std=c++17 -O2 Compilador/Compilador.c++ Compilador/ContadorAlocacoes.c++ -o Compilador
+//   g++ -std=c++17 -O2 Benchmarks/bench_pipeline.c++ Compilador/ContadorAlocacoes.c++ -o bench_pipeline
+//
+// Todas as formas de operator new e delete são substituídas (simples e de array, nothrow, com
+// tamanho e com alinhamento): nenhuma alocação escapa da contagem e toda memória volta para a
+// mesma família de funções que a alocou (malloc e free; nas alocações alinhadas, ver abaixo).
+
+namespace {
+
+// Marca o contador como ativo antes de main.
+struct Ativacao {
+    Ativacao() { contadorAlocacoes.ativo.store(true, memory_order_relaxed); }
+} ativacao;
+
+// Alocações com alinhamento maior que o do malloc. aligned_alloc não existe nos runtimes C do
+// MSVC e do MinGW-w64: no Windows usa _aligned_malloc/_aligned_free; nos outros sistemas pede
+// ao malloc espaço a mais, alinha o ponteiro e guarda logo antes dele o endereço original, que
+// liberarAlinhado devolve ao free.
+void* alocarAlinhado(size_t tamanho, size_t alinhamento) {
+#ifdef _WIN32
+    return _aligned_malloc(tamanho, alinhamento);
+#else
+    if (tamanho > SIZE_MAX - alinhamento - sizeof(void*)) return nullptr;
+    void* original = malloc(tamanho + alinhamento + sizeof(void*));
+    if (!original) return nullptr;
+    uintptr_t endereco = ((uintptr_t)original + sizeof(void*) + alinhamento - 1) & ~(uintptr_t)(alinhamento - 1);
+    ((void**)endereco)[-1] = original;
+    return (void*)endereco;
+#endif
+}
+
+void liberarAlinhado(void* p) noexcept {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    if (p) free(((void**)p)[-1]);
+#endif
+}
+
+// Como o operator new padrão: chama o new_handler enquanto faltar memória e devolve nullptr
+// quando não houver um. 'alinhamento' 0 indica o operator new sem alinhamento explícito.
+void* alocar(size_t n, size_t alinhamento) {
+    size_t tamanho = n ? n : 1;
+    for (;;) {
+        void* p = alinhamento > alignof(max_align_t) ? alocarAlinhado(tamanho, alinhamento) : malloc(tamanho);
+        if (p) {
+            contadorAlocacoes.alocacoes.fetch_add(1, memory_order_relaxed);
+            contadorAlocacoes.bytes.fetch_add(n, memory_order_relaxed);
+            return p;
+        }
+        new_handler tratador = get_new_handler();
+        if (!tratador) return nullptr;
+        tratador();
+    }
+}
+
+void* alocarOuLancar(size_t n, size_t alinhamento) {
+    if (void* p = alocar(n, alinhamento)) return p;
+    throw bad_alloc();
+}
+
+void* alocarSemLancar(size_t n, size_t alinhamento) noexcept {
+    try {
+        return alocar(n, alinhamento);
+    } catch (...) { // O new_handler pode lançar bad_alloc
+        return nullptr;
+    }
+}
+
+// Devolve a memória pela mesma função que alocar usou para esse alinhamento.
+void liberar(void* p, size_t alinhamento) noexcept {
+    if (alinhamento > alignof(max_align_t)) liberarAlinhado(p);
+    else free(p);
+}
+
+} // namespace
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete" // new/delete abaixo usam malloc/free de propósito
+#endif
+
+void* operator new(size_t n) { return alocarOuLancar(n, 0); }
+void* operator new[](size_t n) { return alocarOuLancar(n, 0); }
+void* operator new(size_t n, const nothrow_t&) noexcept { return alocarSemLancar(n, 0); }
+void* operator new[](size_t n, const nothrow_t&) noexcept { return alocarSemLancar(n, 0); }
+void* operator new(size_t n, align_val_t a) { return alocarOuLancar(n, (size_t)a); }
+void* operator new[](size_t n, align_val_t a) { return alocarOuLancar(n, (size_t)a); }
+void* operator new(size_t n, align_val_t a, const nothrow_t&) noexcept { return alocarSemLancar(n, (size_t)a); }
+void* operator new[](size_t n, align_val_t a, const nothrow_t&) noexcept { return alocarSemLancar(n, (size_t)a); }
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+void operator delete(void* p, const nothrow_t&) noexcept { free(p); }
+void operator delete[](void* p, const nothrow_t&) noexcept { free(p); }
+void operator delete(void* p, align_val_t a) noexcept { liberar(p, (size_t)a); }
+void operator delete[](void* p, align_val_t a) noexcept { liberar(p, (size_t)a); }
+void operator delete(void* p, size_t, align_val_t a) noexcept { liberar(p, (size_t)a); }
+void operator delete[](void* p, size_t, align_val_t a) noexcept { liberar(p, (size_t)a); }
+void operator delete(void* p, align_val_t a, const nothrow_t&) noexcept { liberar(p, (size_t)a); }
+void operator delete[](void* p, align_val_t a, const nothrow_t&) noexcept { liberar(p, (size_t)a); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
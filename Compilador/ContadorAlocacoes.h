@@ -0,0 +1,25 @@
+#ifndef CONTADOR_ALOCACOES_H
+#define CONTADOR_ALOCACOES_H
+
+#include <atomic>
+#include <cstddef>
+
+using namespace std;
+
+// Alocações feitas com operator new desde o início do programa.
+//
+// As funções de alocação que contam ficam em ContadorAlocacoes.c++ e só entram nos programas
+// compilados junto com esse arquivo (o Compilador usado para --stats e o bench_pipeline). Nos
+// outros o operator new padrão continua valendo, os contadores ficam parados e 'ativo' é false:
+// o JSON do --stats mostra as alocações como null. Os contadores são atômicos, então a contagem
+// vale também com várias threads (cada fase medida inclui o que as outras alocaram no período).
+struct ContadorAlocacoes {
+    atomic<size_t> alocacoes{0};
+    atomic<size_t> bytes{0};
+    atomic<bool> ativo{false}; // ContadorAlocacoes.c++ foi ligado ao programa
+};
+
+// Inicializado em tempo de compilação: pode ser usado por alocações feitas antes de main.
+inline ContadorAlocacoes contadorAlocacoes;
+
+#endif
@@ -0,0 +1,178 @@
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../Lexico/Lexico.h"
+#include "../Sintatico/Sintatico.h"
+#include "../Semantico/Semantico.h"
+#include "Unidade.h"
+#include "ContadorAlocacoes.h"
+
+using namespace std;
+
+//================================================================================
+// MEDIÇÃO DAS FASES
+//================================================================================
+
+// Tempo e alocações de uma fase da compilação.
+struct MedidaFase {
+    double segundos = 0;
+    size_t alocacoes = 0;
+    size_t bytesAlocados = 0;
+};
+
+// Marca o início de uma fase; parar() devolve o que aconteceu desde então.
+class Cronometro {
+private:
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    size_t alocacoesNoInicio = contadorAlocacoes.alocacoes.load(memory_order_relaxed);
+    size_t bytesNoInicio = contadorAlocacoes.bytes.load(memory_order_relaxed);
+
+public:
+    MedidaFase parar() const {
+        MedidaFase m;
+        m.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        m.alocacoes = contadorAlocacoes.alocacoes.load(memory_order_relaxed) - alocacoesNoInicio;
+        m.bytesAlocados = contadorAlocacoes.bytes.load(memory_order_relaxed) - bytesNoInicio;
+        return m;
+    }
+};
+
+struct EstatisticasCompilacao {
+    size_t bytes = 0;
+    size_t linhas = 0;
+    size_t tokens = 0;
+    size_t errosSintaticos = 0;
+    size_t errosSemanticos = 0;
+
+    MedidaFase lexico, sintatico, semantico;
+
+    size_t nosAST = 0;             // Nós alcançáveis a partir da raiz
+    size_t bytesAST = 0;           // Bytes entregues pela arena (nós e listas de filhos)
+    size_t bytesReservadosAST = 0; // Bytes dos blocos da arena
+    size_t nomesInternados = 0;
+
+    size_t picoSimbolos = 0;       // Maior número de declarações visíveis ao mesmo tempo
+    size_t profundidadeMaxima = 0; // Maior número de escopos abertos ao mesmo tempo
+
+    MedidaFase total() const {
+        return {lexico.segundos + sintatico.segundos + semantico.segundos,
+                lexico.alocacoes + sintatico.alocacoes + semantico.alocacoes,
+                lexico.bytesAlocados + sintatico.bytesAlocados + semantico.bytesAlocados};
+    }
+};
+
+inline size_t contarNos(const ASTNode* no) {
+    if (!no) return 0;
+    size_t n = 1;
+    for (const ASTNode* filho : no->filhos) n += contarNos(filho);
+    return n;
+}
+
+// Léxico -> sintático -> semântico de uma unidade, como compilarUnidade, medindo cada fase.
+// A liberação das estruturas de cada fase fica fora das medidas.
+inline EstatisticasCompilacao medirCompilacao(const string& fonte) {
+    EstatisticasCompilacao e;
+    e.bytes = fonte.size();
+    e.linhas = contarLinhas(fonte);
+
+    Cronometro cronometro;
+    vector<Token> lidos = analisarLexico(fonte);
+    e.lexico = cronometro.parar();
+    e.tokens = lidos.size();
+
+    cronometro = Cronometro();
+    AnalisadorSintatico parser(move(lidos));
+    ASTNode* raiz = parser.programa();
+    e.sintatico = cronometro.parar();
+    e.errosSintaticos = parser.diagnosticos.size();
+
+    cronometro = Cronometro();
+    AnalisadorSemantico analisador(parser.nomes);
+    if (raiz) analisador.verificar(raiz);
+    e.semantico = cronometro.parar();
+    e.errosSemanticos = analisador.erros.size();
+
+    e.nosAST = contarNos(raiz);
+    e.bytesAST = parser.arena.bytesUsados();
+    e.bytesReservadosAST = parser.arena.bytesReservados();
+    e.nomesInternados = parser.nomes.tamanho();
+    e.picoSimbolos = analisador.tabela.maiorQuantidadeSimbolos();
+    e.profundidadeMaxima = analisador.tabela.maiorProfundidade();
+    return e;
+}
+
+//================================================================================
+// SAÍDA EM JSON
+//================================================================================
+
+inline string textoJSON(const string& s) {
+    string r = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') r += '\\';
+        if ((unsigned char)c < 0x20) {
+            static const char* const hex = "0123456789abcdef";
+            r += "\\u00";
+            r += hex[(c >> 4) & 0xF];
+            r += hex[c & 0xF];
+        } else {
+            r += c;
+        }
+    }
+    return r + "\"";
+}
+
+inline string numeroJSON(double x) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.3f", x);
+    return buf;
+}
+
+// Por segundo, sem dividir por zero em fases rápidas demais para o relógio.
+inline double porSegundo(size_t quantidade, double segundos) {
+    return segundos > 0 ? quantidade / segundos : 0;
+}
+
+inline void escreverFaseJSON(ostream& saida, const char* nome, const MedidaFase& m, const string& extra, bool ultima) {
+    saida << "    " << textoJSON(nome) << ": {\"ms\": " << numeroJSON(m.segundos * 1e3);
+    if (contadorAlocacoes.ativo) saida << ", \"alocacoes\": " << m.alocacoes << ", \"bytes_alocados\": " << m.bytesAlocados;
+    else saida << ", \"alocacoes\": null, \"bytes_alocados\": null";
+    saida << extra << "}" << (ultima ? "\n" : ",\n");
+}
+
+// Um objeto JSON com as medidas; os nomes das chaves são estáveis para comparar execuções.
+inline void escreverEstatisticasJSON(ostream& saida, const EstatisticasCompilacao& e, const string& arquivo) {
+    MedidaFase total = e.total();
+    saida << "{\n";
+    saida << "  \"arquivo\": " << textoJSON(arquivo) << ",\n";
+    saida << "  \"bytes\": " << e.bytes << ",\n";
+    saida << "  \"linhas\": " << e.linhas << ",\n";
+    saida << "  \"tokens\": " << e.tokens << ",\n";
+    saida << "  \"erros\": {\"sintaticos\": " << e.errosSintaticos << ", \"semanticos\": " << e.errosSemanticos << "},\n";
+    saida << "  \"fases\": {\n";
+    escreverFaseJSON(saida, "lexico", e.lexico,
+                     ", \"tokens_por_s\": " + numeroJSON(porSegundo(e.tokens, e.lexico.segundos))
+                     + ", \"mb_por_s\": " + numeroJSON(porSegundo(e.bytes, e.lexico.segundos) / 1e6), false);
+    escreverFaseJSON(saida, "sintatico", e.sintatico,
+                     ", \"tokens_por_s\": " + numeroJSON(porSegundo(e.tokens, e.sintatico.segundos)), false);
+    escreverFaseJSON(saida, "semantico", e.semantico,
+                     ", \"nos_por_s\": " + numeroJSON(porSegundo(e.nosAST, e.semantico.segundos)), false);
+    escreverFaseJSON(saida, "total", total,
+                     ", \"linhas_por_s\": " + numeroJSON(porSegundo(e.linhas, total.segundos)), true);
+    saida << "  },\n";
+    saida << "  \"ast\": {\"nos\": " << e.nosAST << ", \"bytes\": " << e.bytesAST
+          << ", \"bytes_reservados\": " << e.bytesReservadosAST
+          << ", \"bytes_por_no\": " << numeroJSON(e.nosAST ? (double)e.bytesAST / e.nosAST : 0)
+          << ", \"nomes_internados\": " << e.nomesInternados << "},\n";
+    saida << "  \"tabela_de_simbolos\": {\"pico_simbolos\": " << e.picoSimbolos
+          << ", \"profundidade_maxima\": " << e.profundidadeMaxima << "}\n";
+    saida << "}\n";
+}
+
+#endif
@@ -0,0 +1,955 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <fstream>
+#include <unordered_set>
+#include <algorithm>
+#include <cstdint>
+#include <cctype>
+#include <cstring>
+#include <cstdio>
+
+#include "../Lexico/Lexico.h"
+#include "../Sintatico/Sintatico.h"
+#include "../Semantico/Semantico.h"
+
+using namespace std;
+
+// Reanálise incremental com cache em disco.
+//
+// O programa é dividido nas regiões de nível mais externo do parser (TipoRegiao): o cabeçalho
+// com as declarações globais, cada função ou procedimento do bloco principal e os comandos do
+// bloco principal. Para cada região o cache guarda o hash dos seus bytes, a AST com os tipos
+// calculados, as declarações que o parser registrou e o resumo semântico (os símbolos que ela
+// deixa declarados no bloco principal). Os tokens não são guardados: a AST já traz tudo que a
+// checagem semântica usa, e os poucos trechos que o parser precisa ver de novo são relidos do
+// fonte, que tem os mesmos bytes. Na execução seguinte:
+//
+//   1. As regiões do cache são casadas com o fonte novo a partir do início e do fim do arquivo.
+//      Só o trecho do meio, o que mudou, passa pelo léxico e pelo parser.
+//   2. Uma região que não mudou só é analisada de novo se o que ela consulta do que as regiões
+//      anteriores declararam mudou: primeiro compara o hash de todo o "ambiente" dela e, se ele
+//      mudou, as suas dependências (ver DEPENDÊNCIAS). O parser relê os bytes da região e a
+//      checagem semântica usa a AST do cache. Regiões com erros semânticos são sempre conferidas.
+//   3. As demais entram apenas com as suas declarações e o seu resumo.
+//
+// Linhas e posições são gravadas relativas ao início da região, então uma região deslocada por
+// uma edição acima dela continua valendo. Se houver erro sintático, ou se o trecho novo não se
+// encaixar nas regiões vizinhas, a unidade é analisada inteira: o resultado é sempre o mesmo
+// da análise completa.
+
+//================================================================================
+// HASH E FORMATO BINÁRIO
+//================================================================================
+
+// Hash de 64 bits dos bytes [p, p + n), 8 bytes por vez. Não é criptográfico: serve para
+// reconhecer trechos que não mudaram.
+inline uint64_t hashBytes(const char* p, size_t n, uint64_t h = 0x9E3779B97F4A7C15ull) {
+    const uint64_t MULT = 0xFF51AFD7ED558CCDull;
+    h ^= n * MULT;
+    for (; n >= 8; p += 8, n -= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        h = (h ^ w) * MULT;
+        h ^= h >> 32;
+    }
+    uint64_t w = 0;
+    if (n) memcpy(&w, p, n);
+    h = (h ^ w) * MULT;
+    return h ^ (h >> 29);
+}
+
+inline uint64_t hashBytes(string_view dados) {
+    return hashBytes(dados.data(), dados.size());
+}
+
+// Acrescenta um valor a um hash encadeado (o ambiente de uma região encadeia as anteriores).
+inline uint64_t encadearHash(uint64_t h, uint64_t valor) {
+    return hashBytes((const char*)&valor, sizeof(valor), h);
+}
+
+constexpr uint64_t AMBIENTE_VAZIO = 0; // Ambiente da primeira região
+
+// Escrita binária compacta: inteiros em varint (7 bits por byte).
+struct EscritorBinario {
+    string dados;
+
+    void byte(uint8_t v) { dados.push_back((char)v); }
+    void varint(uint64_t v) {
+        while (v >= 0x80) {
+            dados.push_back((char)(v | 0x80));
+            v >>= 7;
+        }
+        dados.push_back((char)v);
+    }
+    void inteiro(int64_t v) { varint(((uint64_t)v << 1) ^ (uint64_t)(v >> 63)); } // Zigue-zague: negativos pequenos ficam curtos
+    void u64(uint64_t v) { dados.append((const char*)&v, sizeof(v)); }
+    void texto(string_view t) {
+        varint(t.size());
+        dados.append(t.data(), t.size());
+    }
+};
+
+// Leitura do formato acima. Dados truncados ou corrompidos zeram 'ok' e devolvem zeros.
+struct LeitorBinario {
+    const char* p;
+    const char* fim;
+    bool ok = true;
+
+    explicit LeitorBinario(string_view dados) : p(dados.data()), fim(dados.data() + dados.size()) {}
+
+    size_t restantes() const { return fim - p; }
+    bool terminou() const { return p == fim; }
+
+    uint8_t byte() {
+        if (p >= fim) {
+            ok = false;
+            return 0;
+        }
+        return (uint8_t)*p++;
+    }
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int desloc = 0; desloc < 64; desloc += 7) {
+            uint8_t b = byte();
+            v |= (uint64_t)(b & 0x7F) << desloc;
+            if (!(b & 0x80)) return v;
+        }
+        ok = false;
+        return 0;
+    }
+    int64_t inteiro() {
+        uint64_t z = varint();
+        return (int64_t)(z >> 1) ^ -(int64_t)(z & 1);
+    }
+    uint64_t u64() {
+        uint64_t v = 0;
+        if (restantes() < sizeof(v)) {
+            ok = false;
+            p = fim;
+            return 0;
+        }
+        memcpy(&v, p, sizeof(v));
+        p += sizeof(v);
+        return v;
+    }
+    string_view texto() {
+        uint64_t n = varint();
+        if (n > restantes()) {
+            ok = false;
+            p = fim;
+            return {};
+        }
+        string_view t(p, n);
+        p += n;
+        return t;
+    }
+};
+
+// Textos usados por uma região: cada um é gravado uma vez e referenciado pelo índice, o que
+// deixa a região independente da TabelaDeNomes da execução que a gravou. O índice 0 é "".
+class NomesLocais {
+private:
+    unordered_map<string_view, uint32_t> indice;
+    vector<string_view> textos;
+
+public:
+    NomesLocais() { indiceDe(""); }
+
+    uint32_t indiceDe(string_view t) {
+        auto it = indice.find(t);
+        if (it != indice.end()) return it->second;
+        indice.emplace(t, (uint32_t)textos.size());
+        textos.push_back(t);
+        return (uint32_t)textos.size() - 1;
+    }
+
+    // Tabela de textos seguida do corpo que a referencia.
+    string gravar(const string& corpo) const {
+        EscritorBinario e;
+        e.varint(textos.size());
+        for (string_view t : textos) e.texto(t);
+        return e.dados + corpo;
+    }
+};
+
+// Lê a tabela gravada por NomesLocais::gravar.
+inline vector<string_view> lerNomesLocais(LeitorBinario& l) {
+    vector<string_view> textos;
+    uint64_t n = l.varint();
+    if (n > l.restantes()) {
+        l.ok = false;
+        return textos;
+    }
+    textos.reserve(n);
+    for (uint64_t i = 0; i < n && l.ok; ++i) textos.push_back(l.texto());
+    return textos;
+}
+
+//================================================================================
+// CONTEÚDO DE UMA REGIÃO
+//================================================================================
+
+// Declarações globais no início do bloco principal (depois delas vêm sub-rotinas e comandos).
+inline size_t declaracoesGlobais(ASTNode* bloco) {
+    size_t k = 0;
+    while (k < bloco->filhos.size()) {
+        TipoNo t = bloco->filhos[k]->tipo;
+        if (t != TipoNo::DECLARACAO_ROTULOS && t != TipoNo::DECLARACAO_TIPOS && t != TipoNo::DECLARACAO_VARIAVEIS) break;
+        ++k;
+    }
+    return k;
+}
+
+inline void gravarRegistroNo(EscritorBinario& e, NomesLocais& locais, const TabelaDeNomes& nomes,
+                             ASTNode* no, size_t filhos, int linhaBase) {
+    e.byte((uint8_t)no->tipo);
+    e.byte((uint8_t)no->tipoDado);
+    e.inteiro(no->linha - linhaBase);
+    e.varint(locais.indiceDe(nomes.texto(no->valor)));
+    e.varint(filhos);
+}
+
+// Grava o nó e a sua subárvore em pré-ordem.
+inline void gravarNo(EscritorBinario& e, NomesLocais& locais, const TabelaDeNomes& nomes, ASTNode* no, int linhaBase) {
+    gravarRegistroNo(e, locais, nomes, no, no->filhos.size(), linhaBase);
+    for (ASTNode* filho : no->filhos) gravarNo(e, locais, nomes, filho, linhaBase);
+}
+
+// AST de uma região. A do cabeçalho é o nó do programa com o bloco principal contendo só as
+// declarações globais; sub-rotinas e comandos são regiões próprias.
+inline string serializarArvore(TipoRegiao tipo, ASTNode* no, const TabelaDeNomes& nomes, int linhaBase) {
+    NomesLocais locais;
+    EscritorBinario e;
+    if (tipo == TipoRegiao::CABECALHO) {
+        ASTNode* bloco = no->filhos[0];
+        size_t declaracoes = declaracoesGlobais(bloco);
+        gravarRegistroNo(e, locais, nomes, no, 1, linhaBase);
+        gravarRegistroNo(e, locais, nomes, bloco, declaracoes, linhaBase);
+        for (size_t k = 0; k < declaracoes; ++k) gravarNo(e, locais, nomes, bloco->filhos[k], linhaBase);
+    } else {
+        gravarNo(e, locais, nomes, no, linhaBase);
+    }
+    return locais.gravar(e.dados);
+}
+
+// Os tipos gravados só são restaurados com 'comTipos'; uma árvore que vai ser conferida de
+// novo começa sem eles, como uma árvore recém-saída do parser.
+inline ASTNode* lerNo(LeitorBinario& l, const vector<Nome>& mapa, int linhaBase, bool comTipos, ArenaAST& arena) {
+    uint8_t tipo = l.byte();
+    uint8_t tipoDado = l.byte();
+    int linha = linhaBase + (int)l.inteiro();
+    uint64_t valor = l.varint();
+    uint64_t filhos = l.varint();
+    if (!l.ok || tipo >= (uint8_t)TipoNo::NUM_TIPOS_NO || tipoDado > (uint8_t)TipoDado::ARRAY
+        || valor >= mapa.size() || filhos > l.restantes()) {
+        l.ok = false;
+        return nullptr;
+    }
+    ASTNode* no = criarNo(arena, (TipoNo)tipo, mapa[valor], linha);
+    if (comTipos) no->tipoDado = (TipoDado)tipoDado;
+    no->filhos.reservar((uint32_t)filhos, arena);
+    for (uint64_t k = 0; k < filhos; ++k) {
+        ASTNode* filho = lerNo(l, mapa, linhaBase, comTipos, arena);
+        if (!filho) return nullptr;
+        no->filhos.adicionar(filho, arena);
+    }
+    return no;
+}
+
+inline ASTNode* lerArvore(string_view dados, int linhaBase, bool comTipos, ArenaAST& arena, TabelaDeNomes& nomes) {
+    LeitorBinario l(dados);
+    vector<string_view> textos = lerNomesLocais(l);
+    vector<Nome> mapa;
+    mapa.reserve(textos.size());
+    for (string_view t : textos) mapa.push_back(nomes.internar(t));
+    ASTNode* raiz = l.ok ? lerNo(l, mapa, linhaBase, comTipos, arena) : nullptr;
+    return raiz && l.terminou() ? raiz : nullptr;
+}
+
+inline void gravarArray(EscritorBinario& e, const TipoArray& a) {
+    e.byte((uint8_t)a.elemento);
+    e.inteiro(a.inicio);
+    e.inteiro(a.fim);
+}
+
+// Grava um símbolo; sem 'comLinha' fica só o que ele significa para as outras regiões.
+inline void gravarSimbolo(EscritorBinario& e, const Simbolo& s, const TabelaDeNomes& nomes, bool comLinha, int linhaBase) {
+    e.texto(nomes.texto(s.nome));
+    e.byte((uint8_t)s.categoria);
+    e.byte((uint8_t)s.tipoDado);
+    if (comLinha) e.inteiro(s.linhaDeclaracao - linhaBase);
+    gravarArray(e, s.array);
+    e.byte((uint8_t)s.tipoRetorno);
+    e.byte(s.variadica);
+    e.varint(s.parametros.size());
+    for (const Parametro& p : s.parametros) {
+        e.byte((uint8_t)p.tipo);
+        gravarArray(e, p.array);
+        e.byte(p.porReferencia);
+    }
+}
+
+// Resumo semântico: os símbolos que a região deixa no bloco principal. 'hash' não inclui as
+// linhas, que não mudam o significado das declarações para as outras regiões.
+inline string serializarResumo(const vector<Simbolo>& resumo, const TabelaDeNomes& nomes, int linhaBase, uint64_t& hash) {
+    EscritorBinario comLinhas, semLinhas;
+    comLinhas.varint(resumo.size());
+    semLinhas.varint(resumo.size());
+    for (const Simbolo& s : resumo) {
+        gravarSimbolo(comLinhas, s, nomes, true, linhaBase);
+        gravarSimbolo(semLinhas, s, nomes, false, 0);
+    }
+    hash = hashBytes(semLinhas.dados);
+    return comLinhas.dados;
+}
+
+inline bool lerResumo(string_view dados, int linhaBase, TabelaDeNomes& nomes, vector<Simbolo>& resumo) {
+    LeitorBinario l(dados);
+    auto tipo = [&l]() {
+        uint8_t t = l.byte();
+        if (t > (uint8_t)TipoDado::ARRAY) l.ok = false;
+        return (TipoDado)t;
+    };
+    auto array = [&]() {
+        TipoArray a;
+        a.elemento = tipo();
+        a.inicio = l.inteiro();
+        a.fim = l.inteiro();
+        return a;
+    };
+    uint64_t n = l.varint();
+    if (n > l.restantes()) return false;
+    for (uint64_t i = 0; i < n && l.ok; ++i) {
+        Simbolo s = {0, Categoria::VARIAVEL, TipoDado::INDEFINIDO, 0};
+        s.nome = nomes.internar(l.texto());
+        uint8_t categoria = l.byte();
+        if (categoria > (uint8_t)Categoria::PROGRAMA) return false;
+        s.categoria = (Categoria)categoria;
+        s.tipoDado = tipo();
+        s.linhaDeclaracao = linhaBase + (int)l.inteiro();
+        s.array = array();
+        s.tipoRetorno = tipo();
+        s.variadica = l.byte() != 0;
+        uint64_t parametros = l.varint();
+        if (parametros > l.restantes()) return false;
+        for (uint64_t k = 0; k < parametros && l.ok; ++k) {
+            Parametro p;
+            p.tipo = tipo();
+            p.array = array();
+            p.porReferencia = l.byte() != 0;
+            s.parametros.push_back(p);
+        }
+        resumo.push_back(move(s));
+    }
+    return l.ok && l.terminou();
+}
+
+// Declarações [primeira, fim) registradas pelo parser.
+inline string serializarDeclaracoes(const vector<DeclaracaoSintatica>& declaracoes, size_t primeira, size_t fim) {
+    EscritorBinario e;
+    e.varint(fim - primeira);
+    for (size_t i = primeira; i < fim; ++i) {
+        e.texto(declaracoes[i].nome);
+        e.texto(declaracoes[i].categoria);
+    }
+    return e.dados;
+}
+
+inline bool aplicarDeclaracoes(string_view dados, AnalisadorSintatico& parser) {
+    LeitorBinario l(dados);
+    uint64_t n = l.varint();
+    if (n > l.restantes()) return false;
+    for (uint64_t i = 0; i < n && l.ok; ++i) {
+        DeclaracaoSintatica d;
+        d.nome = string(l.texto());
+        d.categoria = string(l.texto());
+        parser.aplicarDeclaracao(d);
+    }
+    return l.ok && l.terminou();
+}
+
+//================================================================================
+// DEPENDÊNCIAS
+//================================================================================
+
+// Uma região cujo ambiente mudou ainda vale se nada do que ela consulta mudou. O parser só
+// consulta a categoria dos identificadores e rótulos que aparecem nos tokens da região, e a
+// checagem semântica só busca os nomes que aparecem na AST dela; o cache guarda o que essas
+// consultas davam quando a região começou.
+
+// Categoria de um nome na tabela do parser; para um número, se ele é um rótulo declarado.
+inline string categoriaNoParser(const AnalisadorSintatico& parser, const string& nome) {
+    if (!nome.empty() && isdigit((unsigned char)nome[0])) return parser.declaredLabels.count(nome) ? "rotulo" : "";
+    auto it = parser.TabelaSimbolos.find(nome);
+    return it != parser.TabelaSimbolos.end() ? it->second : "";
+}
+
+// As dependências gravam os nomes consultados e um único hash encadeado das respostas, na
+// ordem dos nomes: para decidir se a região vale basta saber se alguma resposta mudou.
+
+// Dependências sintáticas de uma região recém-analisada pelo parser, com os tokens
+// [primeiroToken, fimToken) e as declarações [primeiraDeclaracao, fim). O que a própria região
+// declarou volta ao valor de antes dela; o resto a tabela do parser ainda tem.
+inline string dependenciasSintaticas(const AnalisadorSintatico& parser, size_t primeiroToken, size_t fimToken,
+                                     size_t primeiraDeclaracao) {
+    unordered_map<string_view, string_view> anteriores;
+    for (size_t k = primeiraDeclaracao; k < parser.declaracoes.size(); ++k) {
+        anteriores.emplace(parser.declaracoes[k].nome, parser.declaracoes[k].anterior); // Fica o primeiro registro
+    }
+    unordered_set<string_view> vistos;
+    EscritorBinario corpo;
+    size_t quantidade = 0;
+    uint64_t respostas = 0;
+    for (size_t i = primeiroToken; i < fimToken; ++i) {
+        const Token& t = parser.tokens[i];
+        if ((t.tipo != TIPO_IDENTIFICADOR && t.tipo != TIPO_NUMERO) || !vistos.insert(t.lexema).second) continue;
+        auto it = anteriores.find(t.lexema);
+        corpo.texto(t.lexema);
+        respostas = encadearHash(respostas, hashBytes(it != anteriores.end() ? string(it->second) : categoriaNoParser(parser, t.lexema)));
+        ++quantidade;
+    }
+    EscritorBinario e;
+    e.varint(quantidade);
+    corpo.u64(respostas);
+    return e.dados + corpo.dados;
+}
+
+inline bool dependenciasSintaticasIguais(string_view dados, const AnalisadorSintatico& parser) {
+    LeitorBinario l(dados);
+    uint64_t n = l.varint();
+    uint64_t respostas = 0;
+    for (uint64_t i = 0; i < n && l.ok; ++i) {
+        respostas = encadearHash(respostas, hashBytes(categoriaNoParser(parser, string(l.texto()))));
+    }
+    return l.ok && l.u64() == respostas && l.terminou();
+}
+
+// Hash do símbolo visível com o nome e do escopo dele (0 se o nome não foi declarado).
+inline uint64_t hashVisivel(const AnalisadorSemantico& analisador, Nome nome) {
+    const Simbolo* s = analisador.tabela.buscarSimbolo(nome);
+    if (!s) return 0;
+    EscritorBinario e;
+    e.varint(analisador.tabela.escopoDe(nome));
+    gravarSimbolo(e, *s, analisador.tabelaNomes, false, 0);
+    return hashBytes(e.dados) | 1;
+}
+
+inline void coletarNomes(ASTNode* no, unordered_set<Nome>& nomes) {
+    if (no->valor) nomes.insert(no->valor);
+    for (ASTNode* filho : no->filhos) coletarNomes(filho, nomes);
+}
+
+// Dependências semânticas dos nós 'raizes', antes da checagem deles.
+inline string dependenciasSemanticas(const vector<ASTNode*>& raizes, const AnalisadorSemantico& analisador) {
+    unordered_set<Nome> nomes;
+    for (ASTNode* no : raizes) coletarNomes(no, nomes);
+    EscritorBinario e;
+    e.varint(nomes.size());
+    uint64_t respostas = 0;
+    for (Nome nome : nomes) {
+        e.texto(analisador.tabelaNomes.texto(nome));
+        respostas = encadearHash(respostas, hashVisivel(analisador, nome));
+    }
+    e.u64(respostas);
+    return e.dados;
+}
+
+inline bool dependenciasSemanticasIguais(string_view dados, const AnalisadorSemantico& analisador) {
+    LeitorBinario l(dados);
+    uint64_t n = l.varint();
+    uint64_t respostas = 0;
+    for (uint64_t i = 0; i < n && l.ok; ++i) {
+        Nome nome = analisador.tabelaNomes.procurar(l.texto()); // Nome que ninguém usou: não foi declarado
+        respostas = encadearHash(respostas, nome ? hashVisivel(analisador, nome) : 0);
+    }
+    return l.ok && l.u64() == respostas && l.terminou();
+}
+
+//================================================================================
+// CACHE EM DISCO
+//================================================================================
+
+// Uma região no cache. Os campos de texto apontam para CacheIncremental::memoria.
+struct RegiaoCache {
+    TipoRegiao tipo;
+    bool semErros;              // A checagem semântica da região não encontrou erros
+    uint32_t bytes;             // Tamanho da região no fonte
+    uint32_t linhas;            // Quebras de linha dentro da região
+    uint64_t hashConteudo;      // Hash dos bytes da região
+    uint64_t ambienteSintatico; // Hash encadeado das declarações sintáticas das regiões anteriores
+    uint64_t hashDeclaracoes;
+    uint64_t ambienteSemantico; // Hash encadeado dos resumos das regiões anteriores
+    uint64_t hashResumo;
+    string_view declaracoes, resumo, arvore;
+    string_view dependenciasSintaticas, dependenciasSemanticas;
+};
+
+struct CacheIncremental {
+    vector<RegiaoCache> regioes; // Na ordem do fonte
+    deque<string> memoria;       // Arquivo lido e regiões novas (deque: os textos não mudam de lugar)
+
+    string_view guardar(string dados) {
+        memoria.push_back(move(dados));
+        return memoria.back();
+    }
+};
+
+// Arquivo: assinatura, hash do corpo e corpo (quantidade de regiões e as regiões).
+constexpr char ASSINATURA_CACHE[8] = {'P', 'A', 'S', 'C', 'A', 'C', 'H', '4'}; // Muda junto com TipoNo e com o formato das regiões
+
+// Carrega o cache. Um arquivo ausente, de outra versão ou corrompido deixa o cache vazio.
+inline bool lerCache(const string& caminho, CacheIncremental& cache) {
+    cache.regioes.clear();
+    string conteudo;
+    if (!lerArquivoInteiro(caminho, conteudo)) return false;
+    if (conteudo.size() < 16 || memcmp(conteudo.data(), ASSINATURA_CACHE, 8) != 0) return false;
+    string_view arquivo = cache.guardar(move(conteudo));
+    uint64_t soma;
+    memcpy(&soma, arquivo.data() + 8, sizeof(soma));
+    string_view corpo = arquivo.substr(16);
+    if (hashBytes(corpo) != soma) return false;
+
+    LeitorBinario l(corpo);
+    uint64_t n = l.varint();
+    if (n > l.restantes()) return false;
+    vector<RegiaoCache> regioes(n);
+    for (RegiaoCache& r : regioes) {
+        uint8_t tipo = l.byte();
+        if (tipo > (uint8_t)TipoRegiao::PRINCIPAL) return false;
+        r.tipo = (TipoRegiao)tipo;
+        r.semErros = l.byte() != 0;
+        r.bytes = (uint32_t)l.varint();
+        r.linhas = (uint32_t)l.varint();
+        r.hashConteudo = l.u64();
+        r.ambienteSintatico = l.u64();
+        r.hashDeclaracoes = l.u64();
+        r.ambienteSemantico = l.u64();
+        r.hashResumo = l.u64();
+        r.declaracoes = l.texto();
+        r.resumo = l.texto();
+        r.arvore = l.texto();
+        r.dependenciasSintaticas = l.texto();
+        r.dependenciasSemanticas = l.texto();
+        if (!l.ok || r.bytes == 0) return false;
+    }
+    if (!l.terminou()) return false;
+    cache.regioes = move(regioes);
+    return true;
+}
+
+// Grava o cache em um arquivo temporário e o renomeia, para nunca deixar um cache pela metade.
+inline bool salvarCache(const string& caminho, const CacheIncremental& cache) {
+    EscritorBinario corpo;
+    corpo.varint(cache.regioes.size());
+    for (const RegiaoCache& r : cache.regioes) {
+        corpo.byte((uint8_t)r.tipo);
+        corpo.byte(r.semErros);
+        corpo.varint(r.bytes);
+        corpo.varint(r.linhas);
+        corpo.u64(r.hashConteudo);
+        corpo.u64(r.ambienteSintatico);
+        corpo.u64(r.hashDeclaracoes);
+        corpo.u64(r.ambienteSemantico);
+        corpo.u64(r.hashResumo);
+        corpo.texto(r.declaracoes);
+        corpo.texto(r.resumo);
+        corpo.texto(r.arvore);
+        corpo.texto(r.dependenciasSintaticas);
+        corpo.texto(r.dependenciasSemanticas);
+    }
+    uint64_t soma = hashBytes(corpo.dados);
+
+    string temporario = caminho + ".tmp";
+    {
+        ofstream saida(temporario, ios::binary);
+        if (!saida.is_open()) return false;
+        saida.write(ASSINATURA_CACHE, sizeof(ASSINATURA_CACHE));
+        saida.write((const char*)&soma, sizeof(soma));
+        saida.write(corpo.dados.data(), corpo.dados.size());
+        if (!saida) return false;
+    }
+    return rename(temporario.c_str(), caminho.c_str()) == 0;
+}
+
+//================================================================================
+// ANÁLISE INCREMENTAL
+//================================================================================
+
+// Análise de uma unidade reaproveitando o cache da execução anterior.
+class AnaliseIncremental {
+public:
+    AnalisadorSintatico parser; // Dono da arena e dos nomes de todas as árvores da unidade
+    vector<Diagnostico> erros;  // Erros sintáticos seguidos dos semânticos, como na análise completa
+
+    // Estatísticas da última análise
+    bool completa = false;        // Nada veio do cache (sem cache, cache inválido ou erro sintático)
+    size_t regioesAnalisadas = 0; // Regiões que passaram pelo parser
+    size_t regioesConferidas = 0; // Regiões que passaram pela checagem semântica
+    size_t bytesRelidos = 0;      // Bytes que passaram pelo léxico
+    bool cacheAlterado = false;   // O cache recebeu regiões novas e precisa ser gravado
+
+    size_t regioes() const { return atuais.size(); }
+
+    // Analisa 'fonte' e deixa no cache as regiões dele. Com erros sintáticos o cache não muda.
+    void analisar(const string& fonte, CacheIncremental& cache) {
+        erros.clear();
+        completa = false;
+        regioesAnalisadas = regioesConferidas = bytesRelidos = 0;
+        cacheAlterado = false;
+        erroSintatico = false;
+        if (!cache.regioes.empty()) {
+            if (analisarPorRegioes(fonte, cache.regioes, cache)) return;
+            regioesAnalisadas = regioesConferidas = bytesRelidos = 0;
+        }
+        // Sem nada que sirva do cache as regiões são todas analisadas (é o que preenche o cache),
+        // a não ser que o parser já tenha achado um erro.
+        completa = true;
+        if (!erroSintatico && analisarPorRegioes(fonte, {}, cache)) return;
+        analisarCompleta(fonte);
+    }
+
+    // AST do programa inteiro, montada com as partes que vieram só do cache (nullptr se a
+    // análise sintática não produziu uma árvore). Lê o cache passado a analisar(), que precisa
+    // continuar existindo sem mudanças até aqui; a árvore vale enquanto o objeto existir.
+    ASTNode* arvore() {
+        if (raiz || atuais.empty()) return raiz;
+        for (RegiaoAtual& r : atuais) {
+            if (!r.no) r.no = lerArvore(r.antiga->arvore, r.linhaBase, true, parser.arena, parser.nomes);
+            if (!r.no) return nullptr;
+        }
+        ASTNode* bloco = atuais[0].no->filhos[0];
+        for (size_t k = 1; k < atuais.size(); ++k) bloco->filhos.adicionar(atuais[k].no, parser.arena);
+        raiz = atuais[0].no;
+        return raiz;
+    }
+
+private:
+    // Uma região do fonte atual.
+    struct RegiaoAtual {
+        TipoRegiao tipo = TipoRegiao::SUBROTINA;
+        size_t inicio = 0;                   // Trecho do fonte
+        size_t bytes = 0;
+        uint32_t linhas = 0;
+        int linhaBase = 1;                   // Linha em que a região começa
+        const RegiaoCache* antiga = nullptr; // Entrada do cache com os mesmos bytes (nullptr: trecho novo)
+        bool analisada = false;              // Passou pelo parser nesta execução
+        bool conferida = false;              // Passou pela checagem semântica nesta execução
+        size_t primeiroToken = 0, fimToken = 0; // Em parser.tokens (analisadas)
+        ASTNode* no = nullptr;
+        string declaracoes, resumo;          // Gravados nesta execução
+        string dependenciasSintaticas, dependenciasSemanticas;
+        RegiaoCache nova = {};               // Entrada do cache novo
+    };
+
+    vector<RegiaoAtual> atuais;
+    vector<string_view> pendentes; // Declarações de regiões do cache ainda não aplicadas ao parser
+    ASTNode* raiz = nullptr;
+    bool erroSintatico = false;    // O parser achou um erro em alguma região
+
+    void reiniciar() {
+        atuais.clear();
+        pendentes.clear();
+        raiz = nullptr;
+    }
+
+    // Aplica ao parser as declarações das regiões reaproveitadas antes de analisar a próxima região.
+    bool aplicarPendentes() {
+        for (string_view d : pendentes) {
+            if (!aplicarDeclaracoes(d, parser)) return false;
+        }
+        pendentes.clear();
+        return true;
+    }
+
+    RegiaoAtual regiaoDoCache(const RegiaoCache& antiga, size_t inicio, int linhaBase) {
+        RegiaoAtual r;
+        r.tipo = antiga.tipo;
+        r.inicio = inicio;
+        r.bytes = antiga.bytes;
+        r.linhas = antiga.linhas;
+        r.linhaBase = linhaBase;
+        r.antiga = &antiga;
+        r.nova.hashDeclaracoes = antiga.hashDeclaracoes;
+        return r;
+    }
+
+    // Analisa com o parser a região que começa no token atual. Só serve se não houver erros.
+    bool analisarRegiao(TipoRegiao tipo, RegiaoAtual& r) {
+        size_t primeiraDeclaracao = parser.declaracoes.size();
+        try {
+            if (tipo == TipoRegiao::CABECALHO) parser.cabecalhoPrograma();
+            else if (tipo == TipoRegiao::SUBROTINA) parser.subrotina();
+            else parser.corpoPrincipal();
+        } catch (const LimiteDeErros&) {
+            erroSintatico = true;
+        } catch (const ErroSintatico&) {
+            erroSintatico = true;
+        }
+        if (erroSintatico || !parser.diagnosticos.empty()) {
+            erroSintatico = true;
+            return false;
+        }
+        r.tipo = tipo;
+        r.analisada = true;
+        r.primeiroToken = parser.regioes.back().primeiroToken;
+        r.fimToken = parser.pos;
+        r.no = parser.regioes.back().no;
+        r.declaracoes = serializarDeclaracoes(parser.declaracoes, primeiraDeclaracao, parser.declaracoes.size());
+        r.dependenciasSintaticas = dependenciasSintaticas(parser, r.primeiroToken, r.fimToken, primeiraDeclaracao);
+        r.nova.hashDeclaracoes = hashBytes(r.declaracoes);
+        ++regioesAnalisadas;
+        return true;
+    }
+
+    // Analisa 'fonte' reaproveitando as regiões 'antigas' e guarda as regiões dele no cache.
+    // Devolve false, sem mudar o cache, se a análise por regiões não servir.
+    bool analisarPorRegioes(const string& fonte, const vector<RegiaoCache>& antigas, CacheIncremental& cache) {
+        reiniciar();
+        const char* texto = fonte.data();
+        size_t n = antigas.size();
+
+        // 1. Regiões com os mesmos bytes no início e no fim do arquivo.
+        size_t i = 0, inicioMeio = 0;
+        while (i < n && antigas[i].bytes <= fonte.size() - inicioMeio
+               && hashBytes(texto + inicioMeio, antigas[i].bytes) == antigas[i].hashConteudo) {
+            inicioMeio += antigas[i++].bytes;
+        }
+        size_t j = n, fimMeio = fonte.size();
+        while (j > i && antigas[j - 1].bytes <= fimMeio - inicioMeio
+               && hashBytes(texto + fimMeio - antigas[j - 1].bytes, antigas[j - 1].bytes) == antigas[j - 1].hashConteudo) {
+            fimMeio -= antigas[--j].bytes;
+        }
+
+        // 2. O trecho que mudou passa pelo léxico. Ele é lido junto com a primeira região do
+        //    fim porque precisa terminar entre dois tokens (um comentário aberto, por exemplo,
+        //    engoliria as regiões seguintes).
+        vector<Token> lidos;
+        while (fimMeio > inicioMeio) {
+            size_t fimLeitura = j < n ? fimMeio + antigas[j].bytes : fimMeio;
+            lidos = analisarLexico(texto + inicioMeio, texto + fimLeitura);
+            bytesRelidos += fimLeitura - inicioMeio;
+            int tamanhoMeio = (int)(fimMeio - inicioMeio);
+            size_t quantos = 0;
+            while (quantos < lidos.size() && lidos[quantos].posicao < tamanhoMeio) ++quantos;
+            if (j < n && (quantos == lidos.size() || lidos[quantos].posicao != tamanhoMeio)) return false;
+            if (quantos > 0) {
+                lidos.erase(lidos.begin() + quantos, lidos.end());
+                break;
+            }
+            // Só mudaram espaços ou comentários: o trecho é analisado junto com uma região vizinha.
+            if (j < n) fimMeio += antigas[j++].bytes;
+            else if (i > 0) inicioMeio -= antigas[--i].bytes;
+            else return false;
+        }
+
+        parser.carregarTokens({});
+        int linha = 1;
+        uint64_t ambiente = AMBIENTE_VAZIO;
+        for (size_t k = 0; k < i; ++k) {
+            atuais.push_back(regiaoDoCache(antigas[k], atuais.empty() ? 0 : atuais.back().inicio + atuais.back().bytes, linha));
+            atuais.back().nova.ambienteSintatico = ambiente;
+            pendentes.push_back(antigas[k].declaracoes);
+            ambiente = encadearHash(ambiente, antigas[k].hashDeclaracoes);
+            linha += antigas[k].linhas;
+        }
+
+        // 3. O parser divide o trecho em regiões.
+        if (!lidos.empty()) {
+            for (Token& t : lidos) {
+                t.posicao += (int)inicioMeio;
+                t.linha += linha - 1;
+            }
+
+            if (!aplicarPendentes()) return false;
+            parser.acrescentarTokens(move(lidos));
+            size_t primeiraDoMeio = atuais.size();
+            while (!parser.fimTokens()) {
+                const string& lexema = parser.tokens[parser.pos].lexema;
+                TipoRegiao tipo;
+                if (atuais.empty()) tipo = TipoRegiao::CABECALHO;
+                else if (lexema == "function" || lexema == "procedure") tipo = TipoRegiao::SUBROTINA;
+                else if (lexema == "begin") tipo = TipoRegiao::PRINCIPAL;
+                else return false;
+
+                RegiaoAtual r;
+                if (!analisarRegiao(tipo, r)) return false;
+                r.inicio = atuais.size() == primeiraDoMeio ? inicioMeio : (size_t)parser.tokens[r.primeiroToken].posicao;
+                r.nova.ambienteSintatico = ambiente;
+                ambiente = encadearHash(ambiente, r.nova.hashDeclaracoes);
+                atuais.push_back(move(r));
+            }
+            for (size_t k = primeiraDoMeio; k < atuais.size(); ++k) {
+                RegiaoAtual& r = atuais[k];
+                size_t fim = k + 1 < atuais.size() ? atuais[k + 1].inicio : fimMeio;
+                r.bytes = fim - r.inicio;
+                r.linhas = (uint32_t)count(texto + r.inicio, texto + fim, '\n');
+                r.linhaBase = linha;
+                linha += r.linhas;
+            }
+        }
+
+        // 4. Regiões do fim: o parser só passa de novo pelas que consultam algo que mudou.
+        for (size_t k = j; k < n; ++k) {
+            const RegiaoCache& antiga = antigas[k];
+            RegiaoAtual r = regiaoDoCache(antiga, fimMeio, linha);
+            if (k > j) r.inicio = atuais.back().inicio + atuais.back().bytes;
+            r.nova.ambienteSintatico = ambiente;
+            bool mesmoAmbiente = antiga.ambienteSintatico == ambiente;
+            if (!mesmoAmbiente && !aplicarPendentes()) return false;
+            if (mesmoAmbiente || dependenciasSintaticasIguais(antiga.dependenciasSintaticas, parser)) {
+                pendentes.push_back(antiga.declaracoes);
+            } else {
+                // Os bytes são os mesmos de quando a região foi gravada: o léxico dá os mesmos tokens.
+                vector<Token> lidos = analisarLexico(texto + r.inicio, texto + r.inicio + r.bytes);
+                bytesRelidos += r.bytes;
+                for (Token& t : lidos) {
+                    t.posicao += (int)r.inicio;
+                    t.linha += r.linhaBase - 1;
+                }
+                parser.acrescentarTokens(move(lidos));
+                if (!analisarRegiao(antiga.tipo, r) || !parser.fimTokens()) return false;
+            }
+            ambiente = encadearHash(ambiente, r.nova.hashDeclaracoes);
+            linha += r.linhas;
+            atuais.push_back(move(r));
+        }
+
+        // 5. A sequência precisa ser a de um programa: cabeçalho, sub-rotinas e comandos.
+        if (atuais.empty() || atuais.front().tipo != TipoRegiao::CABECALHO || atuais.back().tipo != TipoRegiao::PRINCIPAL) {
+            return false;
+        }
+        for (size_t k = 1; k + 1 < atuais.size(); ++k) {
+            if (atuais[k].tipo != TipoRegiao::SUBROTINA) return false;
+        }
+
+        if (!conferir()) return false;
+        guardarRegioes(fonte, cache);
+        return true;
+    }
+
+    // Análise da unidade inteira, como em compilarUnidade, para uma unidade que a análise por
+    // regiões não aceitou (erros sintáticos). O cache não muda.
+    void analisarCompleta(const string& fonte) {
+        reiniciar();
+        erros.clear();
+        regioesConferidas = 0;
+        bytesRelidos = fonte.size();
+        parser.carregarTokens(analisarLexico(fonte));
+        raiz = parser.programa();
+        regioesAnalisadas = parser.regioes.size();
+        erros = parser.diagnosticos;
+        if (raiz) { // Mesmo caminho da análise normal: a semântica roda sobre a árvore recuperada.
+            AnalisadorSemantico analisador(parser.nomes);
+            analisador.verificar(raiz);
+            erros.insert(erros.end(), analisador.erros.begin(), analisador.erros.end());
+        }
+    }
+
+    // Checagem semântica região por região. Uma região sem erros, que não passou pelo parser
+    // e cujo ambiente (ou o que ela consulta dele) é o mesmo, só tem o resumo declarado.
+    bool conferir() {
+        // read, write, true e false são sempre declarados: uma região reaproveitada pode usá-los
+        // sem que o nome apareça nas regiões analisadas agora.
+        for (const char* predefinido : {"read", "write", "true", "false"}) parser.nomes.internar(predefinido);
+        AnalisadorSemantico analisador(parser.nomes);
+
+        uint64_t ambiente = AMBIENTE_VAZIO;
+        for (RegiaoAtual& r : atuais) {
+            r.nova.ambienteSemantico = ambiente;
+            const RegiaoCache* antiga = r.antiga;
+            bool cabecalho = r.tipo == TipoRegiao::CABECALHO;
+            if (!r.analisada && antiga->semErros
+                && (antiga->ambienteSemantico == ambiente || dependenciasSemanticasIguais(antiga->dependenciasSemanticas, analisador))) {
+                vector<Simbolo> resumo;
+                if (!lerResumo(antiga->resumo, r.linhaBase, parser.nomes, resumo)) return false;
+                if (cabecalho) {
+                    if (resumo.empty()) return false;
+                    analisador.iniciarPrograma(resumo[0]);
+                    resumo.erase(resumo.begin());
+                }
+                analisador.declararResumo(resumo);
+                r.nova.semErros = true;
+                r.nova.hashResumo = antiga->hashResumo;
+            } else {
+                if (!r.no) r.no = lerArvore(antiga->arvore, r.linhaBase, false, parser.arena, parser.nomes);
+                if (!r.no) return false;
+                size_t errosAntes = analisador.erros.size();
+                vector<Simbolo> resumo;
+                if (cabecalho) {
+                    Simbolo programa = {r.no->valor, Categoria::PROGRAMA, TipoDado::PROGRAMA, r.no->linha};
+                    analisador.iniciarPrograma(programa);
+                    resumo.push_back(programa);
+                    ASTNode* bloco = r.no->filhos[0];
+                    vector<ASTNode*> declaracoes(bloco->filhos.begin(), bloco->filhos.begin() + declaracoesGlobais(bloco));
+                    r.dependenciasSemanticas = dependenciasSemanticas(declaracoes, analisador);
+                    for (ASTNode* declaracao : declaracoes) {
+                        vector<Simbolo> parte = analisador.verificarRegiao(declaracao);
+                        resumo.insert(resumo.end(), parte.begin(), parte.end());
+                    }
+                } else {
+                    r.dependenciasSemanticas = dependenciasSemanticas({r.no}, analisador);
+                    resumo = analisador.verificarRegiao(r.no);
+                }
+                r.nova.semErros = analisador.erros.size() == errosAntes;
+                r.resumo = serializarResumo(resumo, parser.nomes, r.linhaBase, r.nova.hashResumo);
+                r.conferida = true;
+                ++regioesConferidas;
+            }
+            ambiente = encadearHash(ambiente, r.nova.hashResumo);
+        }
+        erros = move(analisador.erros);
+        return true;
+    }
+
+    // Troca as regiões do cache pelas do fonte atual. O que não foi refeito continua apontando
+    // para a memória do cache lido.
+    void guardarRegioes(const string& fonte, CacheIncremental& cache) {
+        vector<RegiaoCache> novas;
+        novas.reserve(atuais.size());
+        cacheAlterado = atuais.size() != cache.regioes.size();
+        for (RegiaoAtual& r : atuais) {
+            RegiaoCache e = r.nova;
+            const RegiaoCache* antiga = r.antiga;
+            e.tipo = r.tipo;
+            e.bytes = (uint32_t)r.bytes;
+            e.linhas = r.linhas;
+            e.hashConteudo = antiga ? antiga->hashConteudo : hashBytes(fonte.data() + r.inicio, r.bytes);
+            if (r.analisada) {
+                e.declaracoes = cache.guardar(move(r.declaracoes));
+                e.dependenciasSintaticas = cache.guardar(move(r.dependenciasSintaticas));
+            } else {
+                e.declaracoes = antiga->declaracoes;
+                e.dependenciasSintaticas = antiga->dependenciasSintaticas;
+            }
+            if (r.conferida) {
+                string arvore = serializarArvore(r.tipo, r.no, parser.nomes, r.linhaBase);
+                // Uma região conferida de novo costuma dar o mesmo resultado (ex.: a que tem erros).
+                bool igual = antiga && antiga->arvore == arvore && antiga->resumo == r.resumo;
+                e.arvore = igual ? antiga->arvore : cache.guardar(move(arvore));
+                e.resumo = igual ? antiga->resumo : cache.guardar(move(r.resumo));
+                igual = igual && antiga->dependenciasSemanticas == r.dependenciasSemanticas;
+                e.dependenciasSemanticas = igual ? antiga->dependenciasSemanticas : cache.guardar(move(r.dependenciasSemanticas));
+            } else {
+                e.arvore = antiga->arvore;
+                e.resumo = antiga->resumo;
+                e.dependenciasSemanticas = antiga->dependenciasSemanticas;
+            }
+            if (!antiga || r.analisada || e.arvore.data() != antiga->arvore.data()
+                || e.dependenciasSemanticas.data() != antiga->dependenciasSemanticas.data() || e.semErros != antiga->semErros
+                || e.ambienteSintatico != antiga->ambienteSintatico || e.ambienteSemantico != antiga->ambienteSemantico) {
+                cacheAlterado = true;
+            }
+            novas.push_back(e);
+        }
+        cache.regioes = move(novas);
+        for (size_t k = 0; k < atuais.size(); ++k) atuais[k].antiga = &cache.regioes[k]; // Para arvore()
+    }
+};
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef POOL_DE_TRABALHO_H
+#define POOL_DE_TRABALHO_H
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+
+// Pool de threads com roubo de tarefas (work stealing).
+//
+// Cada thread tem a sua própria fila de tarefas: retira do fim da sua fila e, quando ela
+// esvazia, rouba do início da fila de outra thread. Uma unidade grande não deixa as outras
+// threads paradas esperando: elas levam o que sobrou na fila de quem está ocupado.
+class PoolDeTrabalho {
+private:
+    struct Fila {
+        mutex trava;
+        deque<size_t> tarefas;
+    };
+
+    size_t numThreads;
+    vector<unique_ptr<Fila>> filas;
+    atomic<size_t> roubos{0};
+
+    bool pegarPropria(size_t id, size_t& tarefa) {
+        Fila& f = *filas[id];
+        lock_guard<mutex> guarda(f.trava);
+        if (f.tarefas.empty()) return false;
+        tarefa = f.tarefas.back();
+        f.tarefas.pop_back();
+        return true;
+    }
+
+    bool roubar(size_t id, size_t& tarefa) {
+        for (size_t k = 1; k < numThreads; ++k) {
+            Fila& f = *filas[(id + k) % numThreads]; // Começa pela vizinha para espalhar os roubos
+            lock_guard<mutex> guarda(f.trava);
+            if (f.tarefas.empty()) continue;
+            tarefa = f.tarefas.front();
+            f.tarefas.pop_front();
+            roubos.fetch_add(1, memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+public:
+    // numThreads = 0 usa todos os núcleos disponíveis.
+    explicit PoolDeTrabalho(size_t threads = 0)
+        : numThreads(threads ? threads : max(1u, thread::hardware_concurrency())) {
+        for (size_t i = 0; i < numThreads; ++i) filas.emplace_back(new Fila());
+    }
+
+    size_t threads() const { return numThreads; }
+    size_t tarefasRoubadas() const { return roubos.load(); }
+
+    // Executa tarefa(0) .. tarefa(quantidade - 1) e espera todas terminarem.
+    // As tarefas não criam novas tarefas: quando nenhuma fila tem trabalho, a thread termina.
+    void executar(size_t quantidade, const function<void(size_t)>& tarefa) {
+        // Cada thread começa com um trecho contíguo das tarefas.
+        for (size_t i = 0; i < numThreads; ++i) {
+            Fila& f = *filas[i];
+            f.tarefas.clear();
+            for (size_t t = quantidade * i / numThreads; t < quantidade * (i + 1) / numThreads; ++t) {
+                f.tarefas.push_front(t); // O fim da fila é a menor tarefa: a dona segue a ordem de entrada
+            }
+        }
+
+        auto trabalhador = [&](size_t id) {
+            size_t t;
+            while (pegarPropria(id, t) || roubar(id, t)) tarefa(t);
+        };
+
+        vector<thread> threads;
+        for (size_t i = 1; i < numThreads; ++i) threads.emplace_back(trabalhador, i);
+        trabalhador(0); // A thread que chamou também trabalha
+        for (thread& th : threads) th.join();
+    }
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef UNIDADE_H
+#define UNIDADE_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "../Lexico/Lexico.h"
+#include "../Sintatico/Sintatico.h"
+#include "../Semantico/Semantico.h"
+
+using namespace std;
+
+// Resultado da compilação de uma unidade (um arquivo fonte).
+struct ResultadoUnidade {
+    bool aberto = true;        // false se o arquivo não pôde ser lido
+    size_t linhas = 0;         // Linhas do código fonte
+    size_t tokens = 0;         // Tokens produzidos pelo analisador léxico
+    vector<Diagnostico> erros; // Erros sintáticos seguidos dos semânticos
+};
+
+// Conta as linhas do fonte (uma última linha sem '\n' também conta).
+inline size_t contarLinhas(const string& fonte) {
+    size_t n = count(fonte.begin(), fonte.end(), '\n');
+    if (!fonte.empty() && fonte.back() != '\n') ++n;
+    return n;
+}
+
+// Léxico -> sintático -> semântico de uma unidade, sem imprimir nada.
+// Todo o estado fica em objetos locais: pode ser chamada por várias threads ao mesmo tempo.
+inline ResultadoUnidade compilarUnidade(const string& fonte) {
+    ResultadoUnidade r;
+    r.linhas = contarLinhas(fonte);
+
+    vector<Token> lidos = analisarLexico(fonte);
+    r.tokens = lidos.size();
+
+    AnalisadorSintatico parser(move(lidos));
+    ASTNode* raiz = parser.programa();
+    r.erros = move(parser.diagnosticos);
+
+    if (raiz) { // A análise semântica roda também sobre a árvore recuperada.
+        AnalisadorSemantico analisador(parser.nomes);
+        analisador.verificar(raiz);
+        r.erros.insert(r.erros.end(), analisador.erros.begin(), analisador.erros.end());
+    }
+    return r;
+}
+
+#endif
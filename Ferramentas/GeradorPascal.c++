@@ -0,0 +1,34 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+
+#include "GeradorPascal.h"
+
+using namespace std;
+
+// Gera um programa Pascal sintético (ver GeradorPascal.h) para medir o compilador.
+//
+//   g++ -std=c++17 -O2 Ferramentas/GeradorPascal.c++ -o GeradorPascal
+//   ./GeradorPascal linhas [semente] [arquivo_saida]      (sem arquivo: saída padrão)
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << "Uso: GeradorPascal linhas [semente] [arquivo_saida]\n";
+        return 1;
+    }
+    size_t linhas = stoul(argv[1]);
+    uint64_t semente = argc > 2 ? stoull(argv[2]) : 1;
+    string programa = gerarProgramaPascal(linhas, semente);
+
+    if (argc > 3) {
+        ofstream saida(argv[3], ios::binary);
+        if (!saida.is_open()) {
+            cout << "Erro ao criar o arquivo de saida: " << argv[3] << endl;
+            return 1;
+        }
+        saida << programa;
+    } else {
+        cout << programa;
+    }
+    return 0;
+}
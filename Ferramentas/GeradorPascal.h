@@ -0,0 +1,377 @@
+#ifndef GERADOR_PASCAL_H
+#define GERADOR_PASCAL_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+// Gera programas Pascal sintéticos, sem erros, com o tamanho pedido (em linhas), para medir o
+// compilador. Usa só o que a gramática do parser aceita: rótulos e goto, tipos (alias e array),
+// variáveis de todos os tipos primitivos, funções e procedimentos com parâmetros por valor e
+// 'var', sub-rotinas aninhadas, if/else, while, for (to e downto), read/write, acesso a array,
+// concatenação de strings e expressões inteiras, reais e lógicas.
+//
+// O mesmo (linhas, semente) gera sempre o mesmo programa. Cada sub-rotina só chama as
+// declaradas antes dela e todos os laços têm contador, então a execução na máquina virtual
+// (Maquina/) sempre termina, ainda que possa parar em um índice de array fora dos limites.
+class GeradorPascal {
+public:
+    explicit GeradorPascal(uint64_t semente = 1) : estado(semente) {}
+
+    string gerar(size_t linhasPedidas) {
+        fonte.clear();
+        linhas = 0;
+        rotinas.clear();
+
+        linha("Program Sintetico;");
+        linha("type");
+        linha("  Vetor = array [1..16] of integer;");
+        linha("  Medidas = array [0..7] of real;");
+        linha("  Contador = integer;");
+        linha("var");
+        linha("  gi, gj, gk: integer;");
+        linha("  gc: Contador;");
+        linha("  gr: real;");
+        linha("  gb: boolean;");
+        linha("  gt: string;");
+        linha("  gv: Vetor;");
+        linha("  gm: Medidas;");
+        linha("");
+
+        const size_t LINHAS_PRINCIPAL = 12;
+        while (linhas + LINHAS_PRINCIPAL < linhasPedidas) gerarRotina();
+        gerarPrincipal();
+        return fonte;
+    }
+
+private:
+    // Assinatura de uma sub-rotina já gerada, para gerar chamadas a ela.
+    struct RotinaGerada {
+        string nome;
+        char retorno;           // 'i', 'r', 'b' (funções) ou 0 (procedimentos)
+        vector<char> parametros; // 'i' integer, 'r' real, 'v' var Vetor, 'k' var integer
+    };
+
+    // Nomes visíveis, por tipo, no trecho sendo gerado.
+    struct Escopo {
+        vector<string> inteiros, reais, logicos, textos, vetores;
+        string contador = "gk"; // Variável livre para os laços
+        string aninhada;        // Função aninhada da sub-rotina atual (vazio se não há)
+    };
+
+    uint64_t estado;
+    string fonte;
+    size_t linhas = 0;
+    vector<RotinaGerada> rotinas;
+    Escopo escopo;
+    int nivel = 0; // Indentação
+
+    // splitmix64: a mesma sequência em qualquer plataforma.
+    uint64_t proximo() {
+        uint64_t z = (estado += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    int sortear(int n) { return (int)(proximo() % (uint64_t)n); }
+
+    const string& escolher(const vector<string>& v) { return v[sortear((int)v.size())]; }
+
+    void linha(const string& texto) {
+        if (!texto.empty()) fonte.append(2 * nivel, ' ');
+        fonte += texto;
+        fonte += '\n';
+        ++linhas;
+    }
+
+    //----------------------------------------------------------------------------
+    // Expressões
+    //----------------------------------------------------------------------------
+
+    string numero() { return to_string(1 + sortear(97)); }
+
+    string elementoVetor() { return escolher(escopo.vetores) + "[" + escolher(escopo.inteiros) + " mod 16 + 1]"; }
+
+    string expressaoInteira(int profundidade) {
+        int caso = sortear(profundidade > 0 ? 8 : 3);
+        switch (caso) {
+            case 0: return numero();
+            case 1: return escolher(escopo.inteiros);
+            case 2: return elementoVetor();
+            case 3: return expressaoInteira(profundidade - 1) + " + " + expressaoInteira(profundidade - 1);
+            case 4: return expressaoInteira(profundidade - 1) + " - " + numero();
+            case 5: return "(" + expressaoInteira(profundidade - 1) + ") * " + numero();
+            case 6: return "(" + expressaoInteira(profundidade - 1) + ") " + (sortear(2) ? "div " : "mod ") + numero();
+            default: {
+                if (!escopo.aninhada.empty() && sortear(2)) return escopo.aninhada + "(" + expressaoInteira(profundidade - 1) + ")";
+                string chamada = chamadaFuncao('i', profundidade - 1);
+                return chamada.empty() ? escolher(escopo.inteiros) : chamada;
+            }
+        }
+    }
+
+    string expressaoReal(int profundidade) {
+        int caso = sortear(profundidade > 0 ? 6 : 2);
+        switch (caso) {
+            case 0: return numero() + "." + to_string(sortear(10));
+            case 1: return escolher(escopo.reais);
+            case 2: return expressaoReal(profundidade - 1) + " * " + expressaoReal(profundidade - 1);
+            case 3: return expressaoInteira(profundidade - 1) + " / " + numero();
+            case 4: return "gm[" + escolher(escopo.inteiros) + " mod 8] + " + expressaoInteira(profundidade - 1);
+            default: {
+                string chamada = chamadaFuncao('r', profundidade - 1);
+                return chamada.empty() ? escolher(escopo.reais) : chamada;
+            }
+        }
+    }
+
+    string expressaoLogica(int profundidade) {
+        static const char* const relacionais[] = {" = ", " <> ", " < ", " <= ", " > ", " >= "};
+        int caso = sortear(profundidade > 0 ? 7 : 2);
+        switch (caso) {
+            case 0: return escolher(escopo.logicos);
+            case 1: return escolher(escopo.inteiros) + relacionais[sortear(6)] + numero();
+            case 2: return expressaoInteira(profundidade - 1) + relacionais[sortear(6)] + expressaoInteira(profundidade - 1);
+            case 3: return expressaoReal(profundidade - 1) + " < " + expressaoReal(profundidade - 1);
+            case 4: return "(" + expressaoLogica(profundidade - 1) + ") " + (sortear(2) ? "and" : "or") + " ("
+                           + expressaoLogica(profundidade - 1) + ")";
+            case 5: return "not (" + expressaoLogica(profundidade - 1) + ")";
+            default: {
+                string chamada = chamadaFuncao('b', profundidade - 1);
+                return chamada.empty() ? escolher(escopo.textos) + " = 'a'" : chamada;
+            }
+        }
+    }
+
+    string argumento(char tipo, int profundidade) {
+        switch (tipo) {
+            case 'i': return expressaoInteira(profundidade);
+            case 'r': return expressaoReal(profundidade);
+            case 'v': return escolher(escopo.vetores);
+            default: return escolher(escopo.inteiros); // 'k': var integer
+        }
+    }
+
+    // Chamada de uma sub-rotina já gerada (função com o retorno pedido, ou procedimento se 0).
+    // Vazia se não há nenhuma.
+    string chamada(char retorno, int profundidade) {
+        for (int tentativa = 0; tentativa < 4 && !rotinas.empty(); ++tentativa) {
+            const RotinaGerada& r = rotinas[rotinas.size() - 1 - sortear((int)min<size_t>(rotinas.size(), 64))];
+            if (r.retorno != retorno) continue;
+            if (r.parametros.empty()) return r.nome;
+            string s = r.nome + "(";
+            for (size_t i = 0; i < r.parametros.size(); ++i) {
+                s += (i ? ", " : "") + argumento(r.parametros[i], max(0, profundidade));
+            }
+            return s + ")";
+        }
+        return "";
+    }
+
+    string chamadaFuncao(char retorno, int profundidade) { return profundidade < 0 ? "" : chamada(retorno, profundidade); }
+
+    //----------------------------------------------------------------------------
+    // Comandos
+    //----------------------------------------------------------------------------
+
+    // Um comando, sem o ';' final. 'profundidade' limita o aninhamento.
+    void comando(int profundidade, bool ultimo) {
+        string fim = ultimo ? "" : ";";
+        int caso = sortear(profundidade > 0 ? 11 : 6);
+        switch (caso) {
+            case 0:
+                linha(escolher(escopo.inteiros) + " := " + expressaoInteira(2) + fim);
+                break;
+            case 1:
+                linha(escolher(escopo.reais) + " := " + expressaoReal(2) + fim);
+                break;
+            case 2:
+                linha(escolher(escopo.logicos) + " := " + expressaoLogica(2) + fim);
+                break;
+            case 3:
+                linha(elementoVetor() + " := " + expressaoInteira(1) + fim);
+                break;
+            case 4:
+                if (sortear(2)) linha(escolher(escopo.textos) + " := " + escolher(escopo.textos) + " + 'x'" + fim);
+                else linha("write(" + escolher(escopo.textos) + ", ' ', " + escolher(escopo.inteiros) + ")" + fim);
+                break;
+            case 5: {
+                string s = chamada(0, 1);
+                linha((s.empty() ? "gi := gi + 1" : s) + fim);
+                break;
+            }
+            case 6:
+                linha("if " + expressaoLogica(2) + " then");
+                blocoOuComando(profundidade - 1, true);
+                linha("else");
+                blocoOuComando(profundidade - 1, ultimo);
+                break;
+            case 7:
+                linha("if " + expressaoLogica(1) + " then");
+                blocoOuComando(profundidade - 1, ultimo);
+                break;
+            case 8: { // Laço com contador; o bloco deixa o par inicialização/laço ser um comando só
+                string c = escopo.contador;
+                linha("begin");
+                ++nivel;
+                linha(c + " := " + to_string(2 + sortear(8)) + ";");
+                linha("while " + c + " > 0 do");
+                linha("begin");
+                ++nivel;
+                comandosSimples(1 + sortear(2));
+                linha(c + " := " + c + " - 1");
+                --nivel;
+                linha("end");
+                --nivel;
+                linha("end" + fim);
+                break;
+            }
+            case 9: {
+                string c = escopo.contador;
+                if (sortear(2)) linha("for " + c + " := 1 to 16 do");
+                else linha("for " + c + " := 16 downto 1 do");
+                ++nivel;
+                linha(escolher(escopo.vetores) + "[" + c + "] := " + escolher(escopo.vetores) + "[" + c + "] + " + numero() + fim);
+                --nivel;
+                break;
+            }
+            default:
+                linha("begin");
+                ++nivel;
+                int n = 1 + sortear(3);
+                for (int i = 0; i < n; ++i) comando(profundidade - 1, i == n - 1);
+                --nivel;
+                linha("end" + fim);
+                break;
+        }
+    }
+
+    // Comandos sem laços, para o corpo dos laços (o contador não pode ser alterado).
+    void comandosSimples(int n) {
+        for (int i = 0; i < n; ++i) {
+            int caso = sortear(3);
+            if (caso == 0) linha(escolher(escopo.reais) + " := " + expressaoReal(1) + ";");
+            else if (caso == 1) linha(escolher(escopo.logicos) + " := " + expressaoLogica(1) + ";");
+            else linha(elementoVetor() + " := " + expressaoInteira(1) + ";");
+        }
+    }
+
+    void blocoOuComando(int profundidade, bool ultimo) {
+        ++nivel;
+        comando(profundidade, ultimo);
+        --nivel;
+    }
+
+    //----------------------------------------------------------------------------
+    // Declarações
+    //----------------------------------------------------------------------------
+
+    Escopo escopoGlobal() const {
+        Escopo e;
+        e.inteiros = {"gi", "gj", "gc"};
+        e.reais = {"gr"};
+        e.logicos = {"gb"};
+        e.textos = {"gt"};
+        e.vetores = {"gv"};
+        return e;
+    }
+
+    // Uma função ou procedimento, às vezes com uma função aninhada que usa as variáveis dela.
+    void gerarRotina() {
+        static const char RETORNOS[] = {0, 0, 'i', 'i', 'r', 'b'};
+        static const char TIPOS_PARAMETRO[] = {'i', 'i', 'r', 'v', 'k'};
+        RotinaGerada r;
+        r.nome = "rotina" + to_string(rotinas.size());
+        r.retorno = RETORNOS[sortear(6)];
+        int quantidade = sortear(4);
+        for (int i = 0; i < quantidade; ++i) r.parametros.push_back(TIPOS_PARAMETRO[sortear(5)]);
+
+        escopo = escopoGlobal();
+        string cabecalho = (r.retorno ? "function " : "procedure ") + r.nome;
+        if (!r.parametros.empty()) {
+            cabecalho += "(";
+            for (size_t i = 0; i < r.parametros.size(); ++i) {
+                string p = "p" + to_string(i);
+                if (i) cabecalho += "; ";
+                switch (r.parametros[i]) {
+                    case 'i': cabecalho += p + ": integer"; escopo.inteiros.push_back(p); break;
+                    case 'r': cabecalho += p + ": real"; escopo.reais.push_back(p); break;
+                    case 'v': cabecalho += "var " + p + ": Vetor"; escopo.vetores.push_back(p); break;
+                    default: cabecalho += "var " + p + ": integer"; escopo.inteiros.push_back(p); break;
+                }
+            }
+            cabecalho += ")";
+        }
+        if (r.retorno) cabecalho += string(": ") + (r.retorno == 'i' ? "integer" : r.retorno == 'r' ? "real" : "boolean");
+        linha(cabecalho + ";");
+
+        bool comRotulo = sortear(4) == 0;
+        if (comRotulo) linha("label 1;");
+        linha("var");
+        linha("  i, j, k: integer;");
+        linha("  x: real;");
+        linha("  b: boolean;");
+        linha("  t: string;");
+        linha("  w: Vetor;");
+        escopo.inteiros.insert(escopo.inteiros.end(), {"i", "j"});
+        escopo.reais.push_back("x");
+        escopo.logicos.push_back("b");
+        escopo.textos.push_back("t");
+        escopo.vetores.push_back("w");
+        escopo.contador = "k";
+
+        if (sortear(3) == 0) { // Função aninhada: usa 'i' da rotina de fora
+            linha("");
+            ++nivel;
+            linha("function ajuste(n: integer): integer;");
+            linha("begin");
+            linha("  ajuste := n * 2 + i");
+            linha("end;");
+            --nivel;
+            escopo.aninhada = "ajuste";
+        }
+
+        linha("begin");
+        ++nivel;
+        linha("t := '" + r.nome + "';");
+        if (comRotulo) {
+            linha("k := 3;");
+            linha("1: k := k - 1;");
+            linha("if k > 0 then goto 1;");
+        }
+        int n = 3 + sortear(6);
+        for (int i = 0; i < n; ++i) comando(2, false);
+        if (r.retorno == 'i') linha(r.nome + " := " + expressaoInteira(2));
+        else if (r.retorno == 'r') linha(r.nome + " := " + expressaoReal(2));
+        else if (r.retorno == 'b') linha(r.nome + " := " + expressaoLogica(2));
+        else linha("gi := gi + 1");
+        --nivel;
+        linha("end;");
+        linha("");
+        rotinas.push_back(r);
+    }
+
+    void gerarPrincipal() {
+        escopo = escopoGlobal();
+        linha("begin");
+        ++nivel;
+        linha("read(gi);");
+        linha("gt := 'inicio';");
+        linha("for gk := 1 to 16 do gv[gk] := gk;");
+        for (int i = 0; i < 4; ++i) comando(1, false);
+        linha("write(gi, ' ', gj, ' ', gr, ' ', gb, ' ', gt)");
+        --nivel;
+        linha("end.");
+    }
+};
+
+// Programa sintético com cerca de 'linhas' linhas (ver GeradorPascal).
+inline string gerarProgramaPascal(size_t linhas, uint64_t semente = 1) {
+    return GeradorPascal(semente).gerar(linhas);
+}
+
+#endif
@@ -0,0 +1,380 @@
+#ifndef LEXICO_H
+#define LEXICO_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <filesystem>
+#include <system_error>
+
+using namespace std;
+
+// Nomes dos tipos de token. O campo Token::tipo sempre aponta para uma destas
+// constantes, então nenhum token aloca memória para guardar o próprio tipo.
+constexpr string_view TIPO_PALAVRA_RESERVADA = "Palavra reservada";
+constexpr string_view TIPO_IDENTIFICADOR     = "Identificador";
+constexpr string_view TIPO_NUMERO            = "Numero";
+constexpr string_view TIPO_STRING            = "String";
+constexpr string_view TIPO_SIMBOLO_SIMPLES   = "Simbolo simples";
+constexpr string_view TIPO_SIMBOLO_COMPOSTO  = "Simbolo composto";
+constexpr string_view TIPO_INVALIDO          = "Invalido";
+
+// Define a estrutura para um token léxico.
+struct Token {
+    string lexema;
+    string_view tipo; // Uma das constantes TIPO_*.
+    int linha;        // Linha real do código fonte onde o token começa.
+    int posicao = 0;  // Byte do buffer analisado onde o token começa.
+};
+
+// Converte o nome de um tipo (ex.: lido de saida.txt) para a constante correspondente.
+inline string_view tipoTokenCanonico(const string& nome) {
+    for (string_view t : {TIPO_PALAVRA_RESERVADA, TIPO_IDENTIFICADOR, TIPO_NUMERO, TIPO_STRING,
+                          TIPO_SIMBOLO_SIMPLES, TIPO_SIMBOLO_COMPOSTO}) {
+        if (t == nome) return t;
+    }
+    return TIPO_INVALIDO;
+}
+
+//================================================================================
+// PALAVRAS RESERVADAS (hash perfeito)
+//================================================================================
+
+// Palavras reservadas, agora com 'label', 'type', 'array', 'of' e 'real'
+constexpr const char* palavrasReservadas[] = {
+    "program", "Program", "var", "function", "begin", "end", "read", "write",
+    "if", "then", "else", "integer", "boolean", "double", "while",
+    "procedure", "goto", "for", "do", "not", "and", "or", "to", "downto",
+    "label", "type", "array", "of", "real", "div", "mod"
+};
+
+constexpr size_t TAM_HASH_RESERVADAS = 64;
+constexpr size_t MAX_TAM_RESERVADA = 9; // "procedure"
+
+constexpr size_t tamanhoConst(const char* s) {
+    size_t n = 0;
+    while (s[n]) ++n;
+    return n;
+}
+
+// Hash sem colisões para o conjunto acima (constantes escolhidas por busca).
+// Usa o tamanho, o primeiro, o segundo e o último caractere; exige tamanho >= 2.
+constexpr size_t hashReservada(const char* s, size_t n) {
+    return (n + (unsigned char)s[0] * 9u + (unsigned char)s[1] + (unsigned char)s[n - 1] * 27u)
+           & (TAM_HASH_RESERVADAS - 1);
+}
+
+struct TabelaReservadas {
+    array<const char*, TAM_HASH_RESERVADAS> palavra{};
+    bool colisao = false;
+};
+
+constexpr TabelaReservadas montarTabelaReservadas() {
+    TabelaReservadas t;
+    for (const char* p : palavrasReservadas) {
+        size_t h = hashReservada(p, tamanhoConst(p));
+        if (t.palavra[h]) t.colisao = true;
+        t.palavra[h] = p;
+    }
+    return t;
+}
+
+constexpr TabelaReservadas TABELA_RESERVADAS = montarTabelaReservadas();
+static_assert(!TABELA_RESERVADAS.colisao, "hashReservada deixou de ser perfeito: ajuste as constantes");
+
+// Verifica se o lexema [s, s+n) é uma palavra reservada: um acesso à tabela e uma comparação.
+inline bool ehPalavraReservada(const char* s, size_t n) {
+    if (n < 2 || n > MAX_TAM_RESERVADA) return false;
+    const char* candidata = TABELA_RESERVADAS.palavra[hashReservada(s, n)];
+    // strncmp para no '\0' da candidata, então candidata[n] só é lido se ela tem n letras ou mais.
+    return candidata && strncmp(candidata, s, n) == 0 && candidata[n] == '\0';
+}
+
+//================================================================================
+// AUTÔMATO (DFA) DO ANALISADOR LÉXICO
+//================================================================================
+
+// Classes de caracteres: cada um dos 256 bytes pertence a exatamente uma.
+enum ClasseChar : uint8_t {
+    CC_OUTRO, CC_LETRA, CC_DIGITO, CC_ESPACO, CC_NOVA_LINHA,
+    CC_PONTO, CC_DOIS_PONTOS, CC_IGUAL, CC_MENOR, CC_MAIOR,
+    CC_ABRE_PAR, CC_FECHA_PAR, CC_ASTERISCO, CC_BARRA,
+    CC_ABRE_CHAVE, CC_FECHA_CHAVE, CC_ASPAS, CC_SIMBOLO,
+    NUM_CLASSES
+};
+
+constexpr array<uint8_t, 256> montarClasses() {
+    array<uint8_t, 256> c{};
+    for (int i = 'a'; i <= 'z'; ++i) c[i] = CC_LETRA;
+    for (int i = 'A'; i <= 'Z'; ++i) c[i] = CC_LETRA;
+    c['_'] = CC_LETRA;
+    for (int i = '0'; i <= '9'; ++i) c[i] = CC_DIGITO;
+    c[' '] = c['\t'] = c['\r'] = c['\v'] = c['\f'] = CC_ESPACO;
+    c['\n'] = CC_NOVA_LINHA;
+    c['.'] = CC_PONTO;
+    c[':'] = CC_DOIS_PONTOS;
+    c['='] = CC_IGUAL;
+    c['<'] = CC_MENOR;
+    c['>'] = CC_MAIOR;
+    c['('] = CC_ABRE_PAR;
+    c[')'] = CC_FECHA_PAR;
+    c['*'] = CC_ASTERISCO;
+    c['/'] = CC_BARRA;
+    c['{'] = CC_ABRE_CHAVE;
+    c['}'] = CC_FECHA_CHAVE;
+    c['\''] = CC_ASPAS;
+    for (char s : {'+', '-', ';', ',', '[', ']', '^'}) c[(unsigned char)s] = CC_SIMBOLO;
+    return c;
+}
+
+constexpr array<uint8_t, 256> CLASSE_CHAR = montarClasses();
+
+// Estados do autômato. E_PARADO significa "sem transição": o token termina ali.
+enum EstadoLexico : uint8_t {
+    E_PARADO, E_INICIO,
+    E_ESPACO, E_IDENT, E_NUM, E_NUM_PONTO, E_REAL,
+    E_DOIS_PONTOS, E_MENOR, E_MAIOR, E_IGUAL, E_PONTO, E_ABRE_PAR, E_BARRA,
+    E_SIMPLES, E_COMPOSTO,
+    E_COMENT_CHAVE, E_COMENT_PAR, E_COMENT_PAR_AST, E_COMENT_LINHA, E_COMENT_FIM,
+    E_STRING, E_STRING_FIM,
+    NUM_ESTADOS
+};
+
+// O que o autômato reconhece ao parar em cada estado.
+enum AceiteLexico : uint8_t {
+    A_NENHUM, A_IGNORAR, A_IDENT, A_NUMERO, A_STRING, A_SIMPLES, A_COMPOSTO
+};
+
+struct AutomatoLexico {
+    uint8_t transicao[NUM_ESTADOS][NUM_CLASSES]{};
+    uint8_t aceite[NUM_ESTADOS]{};
+};
+
+constexpr AutomatoLexico montarAutomato() {
+    AutomatoLexico a;
+    auto todas = [&a](uint8_t de, uint8_t para) {
+        for (int c = 0; c < NUM_CLASSES; ++c) a.transicao[de][c] = para;
+    };
+
+    // Estado inicial: decide o tipo do token pelo primeiro caractere.
+    a.transicao[E_INICIO][CC_LETRA] = E_IDENT;
+    a.transicao[E_INICIO][CC_DIGITO] = E_NUM;
+    a.transicao[E_INICIO][CC_ESPACO] = E_ESPACO;
+    a.transicao[E_INICIO][CC_NOVA_LINHA] = E_ESPACO;
+    a.transicao[E_INICIO][CC_PONTO] = E_PONTO;
+    a.transicao[E_INICIO][CC_DOIS_PONTOS] = E_DOIS_PONTOS;
+    a.transicao[E_INICIO][CC_IGUAL] = E_IGUAL;
+    a.transicao[E_INICIO][CC_MENOR] = E_MENOR;
+    a.transicao[E_INICIO][CC_MAIOR] = E_MAIOR;
+    a.transicao[E_INICIO][CC_ABRE_PAR] = E_ABRE_PAR;
+    a.transicao[E_INICIO][CC_BARRA] = E_BARRA;
+    a.transicao[E_INICIO][CC_FECHA_PAR] = E_SIMPLES;
+    a.transicao[E_INICIO][CC_ASTERISCO] = E_SIMPLES;
+    a.transicao[E_INICIO][CC_FECHA_CHAVE] = E_SIMPLES;
+    a.transicao[E_INICIO][CC_SIMBOLO] = E_SIMPLES;
+    a.transicao[E_INICIO][CC_ABRE_CHAVE] = E_COMENT_CHAVE;
+    a.transicao[E_INICIO][CC_ASPAS] = E_STRING;
+
+    // Espaços e quebras de linha.
+    a.transicao[E_ESPACO][CC_ESPACO] = E_ESPACO;
+    a.transicao[E_ESPACO][CC_NOVA_LINHA] = E_ESPACO;
+
+    // Identificadores e palavras reservadas.
+    a.transicao[E_IDENT][CC_LETRA] = E_IDENT;
+    a.transicao[E_IDENT][CC_DIGITO] = E_IDENT;
+
+    // Números inteiros e reais (ex.: 3.14). "1..10" volta para o inteiro antes do "..".
+    a.transicao[E_NUM][CC_DIGITO] = E_NUM;
+    a.transicao[E_NUM][CC_PONTO] = E_NUM_PONTO;
+    a.transicao[E_NUM_PONTO][CC_DIGITO] = E_REAL;
+    a.transicao[E_REAL][CC_DIGITO] = E_REAL;
+
+    // Símbolos compostos: ":=", "<=", "<>", ">=", "==", "..".
+    a.transicao[E_DOIS_PONTOS][CC_IGUAL] = E_COMPOSTO;
+    a.transicao[E_MENOR][CC_IGUAL] = E_COMPOSTO;
+    a.transicao[E_MENOR][CC_MAIOR] = E_COMPOSTO;
+    a.transicao[E_MAIOR][CC_IGUAL] = E_COMPOSTO;
+    a.transicao[E_IGUAL][CC_IGUAL] = E_COMPOSTO;
+    a.transicao[E_PONTO][CC_PONTO] = E_COMPOSTO;
+
+    // Comentários: { ... }, (* ... *) e // até o fim da linha. Podem ocupar várias linhas.
+    a.transicao[E_ABRE_PAR][CC_ASTERISCO] = E_COMENT_PAR;
+    a.transicao[E_BARRA][CC_BARRA] = E_COMENT_LINHA;
+    todas(E_COMENT_CHAVE, E_COMENT_CHAVE);
+    a.transicao[E_COMENT_CHAVE][CC_FECHA_CHAVE] = E_COMENT_FIM;
+    todas(E_COMENT_PAR, E_COMENT_PAR);
+    a.transicao[E_COMENT_PAR][CC_ASTERISCO] = E_COMENT_PAR_AST;
+    todas(E_COMENT_PAR_AST, E_COMENT_PAR);
+    a.transicao[E_COMENT_PAR_AST][CC_ASTERISCO] = E_COMENT_PAR_AST;
+    a.transicao[E_COMENT_PAR_AST][CC_FECHA_PAR] = E_COMENT_FIM;
+    todas(E_COMENT_LINHA, E_COMENT_LINHA);
+    a.transicao[E_COMENT_LINHA][CC_NOVA_LINHA] = E_PARADO;
+
+    // Strings entre aspas simples; '' dentro da string representa uma aspa.
+    todas(E_STRING, E_STRING);
+    a.transicao[E_STRING][CC_ASPAS] = E_STRING_FIM;
+    a.transicao[E_STRING_FIM][CC_ASPAS] = E_STRING;
+
+    a.aceite[E_ESPACO] = A_IGNORAR;
+    a.aceite[E_COMENT_LINHA] = A_IGNORAR;
+    a.aceite[E_COMENT_FIM] = A_IGNORAR;
+    a.aceite[E_IDENT] = A_IDENT;
+    a.aceite[E_NUM] = A_NUMERO;
+    a.aceite[E_REAL] = A_NUMERO;
+    a.aceite[E_STRING_FIM] = A_STRING;
+    a.aceite[E_SIMPLES] = A_SIMPLES;
+    a.aceite[E_DOIS_PONTOS] = A_SIMPLES;
+    a.aceite[E_MENOR] = A_SIMPLES;
+    a.aceite[E_MAIOR] = A_SIMPLES;
+    a.aceite[E_IGUAL] = A_SIMPLES;
+    a.aceite[E_PONTO] = A_SIMPLES;
+    a.aceite[E_ABRE_PAR] = A_SIMPLES;
+    a.aceite[E_BARRA] = A_SIMPLES;
+    a.aceite[E_COMPOSTO] = A_COMPOSTO;
+    return a;
+}
+
+constexpr AutomatoLexico AUTOMATO = montarAutomato();
+
+//================================================================================
+// ANÁLISE LÉXICA
+//================================================================================
+
+// Analisa o buffer [inicio, fim) e devolve a lista de tokens em memória.
+// Cada token guarda a linha do fonte e o byte (a partir de 'inicio') em que começa.
+inline vector<Token> analisarLexico(const char* inicio, const char* fim) {
+    vector<Token> tokens;
+    tokens.reserve((fim - inicio) / 4); // Estimativa: um token a cada poucos bytes.
+
+    const char* p = inicio;
+    int linha = 1;
+    while (p < fim) {
+        const char* lexemaInicio = p;
+        int linhaToken = linha;
+
+        // Maior casamento: anda pelo autômato lembrando o último estado de aceitação.
+        uint8_t estado = E_INICIO;
+        uint8_t aceite = A_NENHUM;
+        const char* fimAceite = p;
+        int linhaAceite = linha;
+        while (p < fim) {
+            uint8_t proximo = AUTOMATO.transicao[estado][CLASSE_CHAR[(unsigned char)*p]];
+            if (proximo == E_PARADO) break;
+            if (*p == '\n') ++linha;
+            estado = proximo;
+            ++p;
+            if (AUTOMATO.aceite[estado] != A_NENHUM) {
+                aceite = AUTOMATO.aceite[estado];
+                fimAceite = p;
+                linhaAceite = linha;
+            }
+        }
+
+        // Comentário aberto até o fim do arquivo: o abre-comentário vira um token inválido na linha
+        // em que o comentário começou (como a string sem a aspa final) e o resto é ignorado.
+        if (p == fim && (estado == E_COMENT_CHAVE || estado == E_COMENT_PAR || estado == E_COMENT_PAR_AST)) {
+            size_t abertura = *lexemaInicio == '{' ? 1 : 2; // "{" ou "(*"
+            tokens.push_back({string(lexemaInicio, abertura), TIPO_INVALIDO, linhaToken, (int)(lexemaInicio - inicio)});
+            break;
+        }
+
+        if (aceite == A_NENHUM) {
+            // String sem a aspa final vai até o fim do arquivo; um caractere inválido vira um token sozinho.
+            if (estado != E_STRING) {
+                p = lexemaInicio + 1;
+                linha = linhaToken;
+            }
+            tokens.push_back({string(lexemaInicio, p), TIPO_INVALIDO, linhaToken, (int)(lexemaInicio - inicio)});
+            continue;
+        }
+
+        p = fimAceite; // Devolve o que foi lido além do último aceite (ex.: "1..10").
+        linha = linhaAceite;
+        size_t n = p - lexemaInicio;
+
+        switch (aceite) {
+            case A_IGNORAR:
+                break;
+            case A_IDENT:
+                tokens.push_back({string(lexemaInicio, n),
+                                  ehPalavraReservada(lexemaInicio, n) ? TIPO_PALAVRA_RESERVADA : TIPO_IDENTIFICADOR,
+                                  linhaToken, (int)(lexemaInicio - inicio)});
+                break;
+            case A_NUMERO:
+                tokens.push_back({string(lexemaInicio, n), TIPO_NUMERO, linhaToken, (int)(lexemaInicio - inicio)});
+                break;
+            case A_STRING:
+                tokens.push_back({string(lexemaInicio, n), TIPO_STRING, linhaToken, (int)(lexemaInicio - inicio)});
+                break;
+            case A_SIMPLES:
+                tokens.push_back({string(lexemaInicio, n), TIPO_SIMBOLO_SIMPLES, linhaToken, (int)(lexemaInicio - inicio)});
+                break;
+            case A_COMPOSTO:
+                tokens.push_back({string(lexemaInicio, n), TIPO_SIMBOLO_COMPOSTO, linhaToken, (int)(lexemaInicio - inicio)});
+                break;
+        }
+    }
+    return tokens;
+}
+
+inline vector<Token> analisarLexico(const string& fonte) {
+    return analisarLexico(fonte.data(), fonte.data() + fonte.size());
+}
+
+// Lê a entrada inteira para um buffer e a analisa de uma vez.
+inline vector<Token> analisarLexico(istream& arquivo) {
+    stringstream buffer;
+    buffer << arquivo.rdbuf();
+    return analisarLexico(buffer.str());
+}
+
+// Carrega o arquivo inteiro em memória. Retorna false se não conseguir abri-lo ou lê-lo inteiro
+// (um diretório, por exemplo). Entradas sem posição, como um pipe, são lidas em sequência.
+inline bool lerArquivoInteiro(const string& caminho, string& conteudo) {
+    error_code erro;
+    if (filesystem::is_directory(caminho, erro)) return false;
+    ifstream arquivo(caminho, ios::binary);
+    if (!arquivo.is_open()) return false;
+    arquivo.seekg(0, ios::end);
+    streamoff tamanho = arquivo.tellg();
+    if (tamanho < 0) {
+        arquivo.clear();
+        ostringstream buffer;
+        buffer << arquivo.rdbuf(); // Entrada vazia só marca 'buffer' com failbit: não é erro
+        if (arquivo.bad()) return false;
+        conteudo = buffer.str();
+        return true;
+    }
+    arquivo.seekg(0, ios::beg);
+    conteudo.resize((size_t)tamanho);
+    if (!conteudo.empty() && !arquivo.read(&conteudo[0], conteudo.size())) return false; // Erro ou leitura curta
+    return true;
+}
+
+// Escreve a tabela de tokens no formato de saida.txt (Lexema, Tipo e, opcionalmente, Linha).
+inline void imprimirTabelaTokens(ostream& saida, const vector<Token>& tokens, bool comLinha) {
+    // Configuração da tabela para impressão
+    const int lexemaWidth = 20; // Largura da coluna "Lexema"
+    const int tipoWidth = 25; // Largura da coluna "Tipo"
+
+    // Cabeçalho (com linha de separação)
+    saida << left << setw(lexemaWidth) << "Lexema" << setw(tipoWidth) << "Tipo";
+    if (comLinha) saida << "Linha";
+    saida << endl;
+    saida << string(lexemaWidth + tipoWidth + (comLinha ? 10 : 0), '-') << endl;
+
+    for (const Token& t : tokens) {
+        saida << left << setw(lexemaWidth) << t.lexema << setw(tipoWidth) << t.tipo;
+        if (comLinha) saida << t.linha;
+        saida << endl;
+    }
+}
+
+#endif
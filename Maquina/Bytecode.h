@@ -0,0 +1,195 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+//================================================================================
+// CONJUNTO DE INSTRUÇÕES
+//================================================================================
+
+// Instruções da máquina de pilha (ver MaquinaVirtual.h). O código é um vetor de palavras de
+// 32 bits: o código da instrução seguido dos seus operandos. Os nomes já foram resolvidos pelo
+// gerador: variáveis viram posições (slots) do quadro da sub-rotina, sub-rotinas viram índices
+// em ProgramaBytecode::rotinas e os rótulos viram endereços no código.
+//
+// Sufixos: _I integer (e boolean nas comparações), _R real, _T string. LOCAL é o quadro atual,
+// GLOBAL o do programa principal e EXTERNO o de uma sub-rotina envolvente, 'saltos' ligações
+// estáticas acima.
+//
+// X(nome, operandos, efeito na pilha). EMPILHA_BLOCO, COPIA_BLOCO e CHAMA têm efeito variável
+// (ver GeradorBytecode).
+#define OPCODES(X)                                                                              \
+    X(EMPILHA_INT, 1, 1)         /* imediato de 32 bits */                                      \
+    X(EMPILHA_CONST, 1, 1)       /* k: ProgramaBytecode::constantes[k] */                       \
+    X(EMPILHA_TEXTO, 1, 1)       /* k: ProgramaBytecode::textos[k] */                           \
+    X(DESCARTA, 0, -1)                                                                          \
+    X(CARREGA_LOCAL, 1, 1)       /* slot */                                                     \
+    X(ARMAZENA_LOCAL, 1, -1)     /* slot */                                                     \
+    X(CARREGA_GLOBAL, 1, 1)      /* slot */                                                     \
+    X(ARMAZENA_GLOBAL, 1, -1)    /* slot */                                                     \
+    X(CARREGA_EXTERNO, 2, 1)     /* saltos, slot */                                             \
+    X(ARMAZENA_EXTERNO, 2, -1)   /* saltos, slot */                                             \
+    X(ENDERECO_LOCAL, 1, 1)      /* slot: empilha a posição da variável na pilha */             \
+    X(ENDERECO_GLOBAL, 1, 1)     /* slot */                                                     \
+    X(ENDERECO_EXTERNO, 2, 1)    /* saltos, slot */                                             \
+    X(CARREGA_INDIRETO, 0, 0)    /* endereço -> valor */                                        \
+    X(ARMAZENA_INDIRETO, 0, -2)  /* endereço, valor -> */                                       \
+    X(INDICE, 2, -1)             /* inicio, tamanho: endereço do array, índice -> endereço */   \
+    X(EMPILHA_BLOCO, 1, 0)       /* tamanho: endereço do array -> elementos */                  \
+    X(COPIA_BLOCO, 1, -2)        /* tamanho: destino, origem -> */                              \
+    X(INCREMENTA_LOCAL, 2, 0)    /* slot, imediato */                                           \
+    X(SOMA_I, 0, -1)                                                                            \
+    X(SUBTRAI_I, 0, -1)                                                                         \
+    X(MULTIPLICA_I, 0, -1)                                                                      \
+    X(DIV_I, 0, -1)                                                                             \
+    X(MOD_I, 0, -1)                                                                             \
+    X(NEGA_I, 0, 0)                                                                             \
+    X(NAO_BIT_I, 0, 0)                                                                          \
+    X(SOMA_IMEDIATO, 1, 0)       /* imediato */                                                 \
+    X(SOMA_R, 0, -1)                                                                            \
+    X(SUBTRAI_R, 0, -1)                                                                         \
+    X(MULTIPLICA_R, 0, -1)                                                                      \
+    X(DIVIDE_R, 0, -1)                                                                          \
+    X(NEGA_R, 0, 0)                                                                             \
+    X(INT_PARA_REAL, 0, 0)                                                                      \
+    X(CONCATENA, 0, -1)                                                                         \
+    X(IGUAL_I, 0, -1)                                                                           \
+    X(DIFERENTE_I, 0, -1)                                                                       \
+    X(MENOR_I, 0, -1)                                                                           \
+    X(MENOR_IGUAL_I, 0, -1)                                                                     \
+    X(MAIOR_I, 0, -1)                                                                           \
+    X(MAIOR_IGUAL_I, 0, -1)                                                                     \
+    X(IGUAL_R, 0, -1)                                                                           \
+    X(DIFERENTE_R, 0, -1)                                                                       \
+    X(MENOR_R, 0, -1)                                                                           \
+    X(MENOR_IGUAL_R, 0, -1)                                                                     \
+    X(MAIOR_R, 0, -1)                                                                           \
+    X(MAIOR_IGUAL_R, 0, -1)                                                                     \
+    X(IGUAL_T, 0, -1)                                                                           \
+    X(DIFERENTE_T, 0, -1)                                                                       \
+    X(MENOR_T, 0, -1)                                                                           \
+    X(MENOR_IGUAL_T, 0, -1)                                                                     \
+    X(MAIOR_T, 0, -1)                                                                           \
+    X(MAIOR_IGUAL_T, 0, -1)                                                                     \
+    X(E, 0, -1)                                                                                 \
+    X(OU, 0, -1)                                                                                \
+    X(NAO, 0, 0)                                                                                \
+    X(SALTA, 1, 0)               /* destino */                                                  \
+    X(SALTA_SE_FALSO, 1, -1)     /* destino */                                                  \
+    X(SALTA_SE_VERDADEIRO, 1, -1)                                                               \
+    X(SALTA_SE_IGUAL_I, 1, -2)   /* destino: compara dois inteiros e salta se for verdade */    \
+    X(SALTA_SE_DIFERENTE_I, 1, -2)                                                              \
+    X(SALTA_SE_MENOR_I, 1, -2)                                                                  \
+    X(SALTA_SE_MENOR_IGUAL_I, 1, -2)                                                            \
+    X(SALTA_SE_MAIOR_I, 1, -2)                                                                  \
+    X(SALTA_SE_MAIOR_IGUAL_I, 1, -2)                                                            \
+    X(CHAMA, 2, 0)               /* rotina, saltos: os argumentos já estão na pilha */          \
+    X(RETORNA, 0, 0)             /* fim de procedimento */                                      \
+    X(RETORNA_VALOR, 1, 0)       /* slot do valor de retorno: fim de função */                  \
+    X(LE_I, 0, -1)               /* endereço da variável lida */                                \
+    X(LE_R, 0, -1)                                                                              \
+    X(LE_B, 0, -1)                                                                              \
+    X(LE_T, 0, -1)                                                                              \
+    X(ESCREVE_I, 0, -1)                                                                         \
+    X(ESCREVE_R, 0, -1)                                                                         \
+    X(ESCREVE_B, 0, -1)                                                                         \
+    X(ESCREVE_T, 0, -1)                                                                         \
+    X(ESCREVE_FIM_LINHA, 0, 0)                                                                  \
+    X(PARA, 0, 0)
+
+enum class OpCodigo : uint8_t {
+#define X_ENUM(nome, operandos, efeito) nome,
+    OPCODES(X_ENUM)
+#undef X_ENUM
+    NUM_OPCODES
+};
+
+struct InfoOpCodigo {
+    const char* nome;
+    uint8_t operandos; // Palavras depois do código da instrução
+    int8_t efeito;     // Variação da altura da pilha
+};
+
+inline const InfoOpCodigo& infoOpCodigo(OpCodigo op) {
+    static const InfoOpCodigo info[] = {
+#define X_INFO(nome, operandos, efeito) {#nome, operandos, efeito},
+        OPCODES(X_INFO)
+#undef X_INFO
+    };
+    return info[(size_t)op];
+}
+
+//================================================================================
+// PROGRAMA
+//================================================================================
+
+// Valor em uma posição da pilha. Strings são referências às strings da máquina; endereços
+// são posições na pilha; boolean é 0 ou 1.
+union Valor {
+    int64_t i;
+    double r;
+};
+static_assert(sizeof(Valor) == 8, "Valor deve ocupar 8 bytes");
+
+// Sub-rotina compilada. O quadro de uma chamada começa nos parâmetros (empilhados por quem
+// chama) e segue com o valor de retorno, as variáveis locais e os temporários.
+struct Rotina {
+    string nome;
+    int32_t inicio = 0;      // Endereço da primeira instrução
+    int32_t parametros = 0;  // Slots ocupados pelos parâmetros
+    int32_t quadro = 0;      // Slots do quadro inteiro
+    int32_t pilhaMaxima = 0; // Maior altura da pilha de operandos acima do quadro
+    int32_t nivel = 0;       // Profundidade de aninhamento (0 = programa principal)
+};
+
+struct ProgramaBytecode {
+    vector<int32_t> codigo;
+    vector<Valor> constantes;              // Inteiros que não cabem em 32 bits e reais
+    vector<bool> constanteReal;            // Para a listagem
+    vector<string> textos = {""};          // Strings literais; a 0 é a string vazia
+    vector<Rotina> rotinas;                // A rotina 0 é o programa principal
+    vector<pair<int32_t, int>> linhas;     // (endereço, linha do fonte), em ordem de endereço
+
+    // Linha do fonte da instrução no endereço 'pc' (0 se desconhecida).
+    int linhaDe(int32_t pc) const {
+        auto it = upper_bound(linhas.begin(), linhas.end(), make_pair(pc, INT32_MAX));
+        return it == linhas.begin() ? 0 : prev(it)->second;
+    }
+};
+
+// Lista as instruções do programa, uma por linha, abrindo cada sub-rotina com o seu nome.
+inline void imprimirBytecode(ostream& saida, const ProgramaBytecode& programa) {
+    vector<const Rotina*> porInicio;
+    for (const Rotina& r : programa.rotinas) porInicio.push_back(&r);
+    sort(porInicio.begin(), porInicio.end(), [](const Rotina* a, const Rotina* b) { return a->inicio < b->inicio; });
+    size_t proxima = 0;
+    for (size_t pc = 0; pc < programa.codigo.size();) {
+        while (proxima < porInicio.size() && (size_t)porInicio[proxima]->inicio <= pc) {
+            const Rotina& r = *porInicio[proxima++];
+            saida << r.nome << ": (parametros " << r.parametros << ", quadro " << r.quadro << ", nivel " << r.nivel << ")\n";
+        }
+        OpCodigo op = (OpCodigo)programa.codigo[pc];
+        const InfoOpCodigo& info = infoOpCodigo(op);
+        saida << "  " << setw(6) << pc << "  " << info.nome;
+        for (int k = 1; k <= info.operandos; ++k) saida << (k == 1 ? " " : ", ") << programa.codigo[pc + k];
+        int32_t k = info.operandos ? programa.codigo[pc + 1] : 0;
+        if (op == OpCodigo::CHAMA) saida << "  ; " << programa.rotinas[k].nome;
+        if (op == OpCodigo::EMPILHA_TEXTO) saida << "  ; '" << programa.textos[k] << "'";
+        if (op == OpCodigo::EMPILHA_CONST) {
+            saida << "  ; ";
+            if (programa.constanteReal[k]) saida << programa.constantes[k].r;
+            else saida << programa.constantes[k].i;
+        }
+        saida << "\n";
+        pc += 1 + info.operandos;
+    }
+}
+
+#endif
@@ -0,0 +1,752 @@
+#ifndef GERADOR_BYTECODE_H
+#define GERADOR_BYTECODE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdlib>
+#include <cstdint>
+
+#include "../Sintatico/Sintatico.h"
+#include "Bytecode.h"
+
+using namespace std;
+
+// Geração de bytecode a partir da AST já conferida pela análise semântica (sem erros): os tipos
+// de cada expressão vêm de ASTNode::tipoDado, então o gerador só escolhe as instruções e resolve
+// os nomes para posições nos quadros.
+//
+// Os nomes são resolvidos de novo aqui, com o mesmo esquema de escopos da TabelaDeSimbolos
+// (cadeia de sombreamento e log de desfazer), porque a tabela da análise semântica é desfeita
+// ao sair de cada escopo.
+
+// Tipo de uma variável, com o que a geração precisa dos arrays.
+struct TipoGerado {
+    TipoDado tipo = TipoDado::INDEFINIDO;
+    TipoDado elemento = TipoDado::INDEFINIDO;
+    int32_t inicio = 0;  // Menor índice (arrays)
+    int32_t tamanho = 1; // Elementos (arrays)
+
+    int32_t slots() const { return tipo == TipoDado::ARRAY ? tamanho : 1; }
+};
+
+// O que um nome significa para a geração de código.
+struct Vinculo {
+    enum Categoria : uint8_t { VARIAVEL, REFERENCIA, ROTINA, TIPO, CONSTANTE, LEITURA, ESCRITA, OUTRO };
+    Categoria categoria = OUTRO;
+    TipoGerado tipo;       // VARIAVEL, REFERENCIA (o tipo da variável apontada) e TIPO
+    int32_t nivel = 0;     // VARIAVEL e REFERENCIA: nível da sub-rotina dona do quadro
+    int32_t slot = 0;      // VARIAVEL e REFERENCIA (onde está o endereço)
+    int32_t rotina = -1;   // ROTINA
+    int64_t valor = 0;     // CONSTANTE
+};
+
+// Parâmetro de uma rotina gerada.
+struct ParametroGerado {
+    TipoGerado tipo;
+    bool porReferencia;
+};
+
+// Escopos da geração: mesma estrutura da TabelaDeSimbolos (ver Semantico.h).
+class TabelaDeVinculos {
+private:
+    struct Entrada {
+        Nome nome;
+        Vinculo vinculo;
+        int anterior; // Entrada do mesmo nome que esta esconde (-1 = nenhuma)
+    };
+    vector<Entrada> entradas;
+    vector<int> visivel;
+    vector<size_t> inicioEscopo;
+
+public:
+    TabelaDeVinculos() { entrarEscopo(); }
+
+    void entrarEscopo() { inicioEscopo.push_back(entradas.size()); }
+
+    void sairEscopo() {
+        size_t inicio = inicioEscopo.back();
+        while (entradas.size() > inicio) {
+            visivel[entradas.back().nome] = entradas.back().anterior;
+            entradas.pop_back();
+        }
+        inicioEscopo.pop_back();
+    }
+
+    void declarar(Nome nome, const Vinculo& v) {
+        if (nome >= visivel.size()) visivel.resize(nome + 1, -1);
+        entradas.push_back({nome, v, visivel[nome]});
+        visivel[nome] = (int)entradas.size() - 1;
+    }
+
+    const Vinculo* buscar(Nome nome) const {
+        if (nome < visivel.size() && visivel[nome] >= 0) return &entradas[visivel[nome]].vinculo;
+        return nullptr;
+    }
+};
+
+class GeradorBytecode {
+public:
+    vector<Diagnostico> erros; // Construções que a máquina não executa (ex.: goto para fora da sub-rotina)
+
+    explicit GeradorBytecode(const TabelaDeNomes& nomesDaUnidade) : nomes(nomesDaUnidade) {}
+
+    // Gera o programa inteiro. Devolve false (com 'erros') se alguma parte não pôde ser gerada.
+    bool gerar(ASTNode* noPrograma, ProgramaBytecode& saida) {
+        p = &saida;
+        p->rotinas.push_back({});
+        p->rotinas[0].nome = "programa " + nomes.texto(noPrograma->valor);
+        assinaturas.push_back({});
+        declararPredefinidos();
+
+        emAndamento.emplace_back(0, 0);
+        gerarBloco(noPrograma->filhos[0]);
+        emitir(OpCodigo::PARA);
+        fecharRotina();
+        return erros.empty();
+    }
+
+private:
+    // Sub-rotina cujo código está sendo gerado.
+    struct RotinaEmAndamento {
+        RotinaEmAndamento(int32_t indiceRotina, int32_t nivelRotina) : indice(indiceRotina), nivel(nivelRotina) {}
+
+        int32_t indice;
+        int32_t nivel;
+        int32_t proximoSlot = 0;
+        int32_t slots = 0;       // Maior valor de proximoSlot
+        int32_t altura = 0;      // Altura atual da pilha de operandos
+        unordered_map<Nome, int32_t> rotulos;     // Rótulo -> endereço do comando marcado
+        vector<pair<int32_t, ASTNode*>> pendentes; // Operandos de 'goto' ainda sem destino
+    };
+
+    const TabelaDeNomes& nomes;
+    ProgramaBytecode* p = nullptr;
+    TabelaDeVinculos tabela;
+    vector<vector<ParametroGerado>> assinaturas; // Por rotina
+    vector<int32_t> resultadoDe;                 // Slot do valor de retorno de cada função (-1 nas outras rotinas)
+    vector<RotinaEmAndamento> emAndamento;       // Pilha: a última é a atual
+    unordered_map<string, int32_t> indiceTexto;
+    int linhaAtual = 0;
+    int32_t ultimaInstrucao = -1; // Endereço da última instrução emitida (para fundir comparação e desvio)
+
+    RotinaEmAndamento& atual() { return emAndamento.back(); }
+
+    void erro(int linha, const string& mensagem) {
+        erros.push_back({linha, "Erro na geracao de codigo na linha " + to_string(linha) + ": " + mensagem});
+    }
+
+    void declararPredefinidos() {
+        Vinculo v;
+        v.categoria = Vinculo::LEITURA;
+        if (Nome n = nomes.procurar("read")) tabela.declarar(n, v);
+        v.categoria = Vinculo::ESCRITA;
+        if (Nome n = nomes.procurar("write")) tabela.declarar(n, v);
+        v.categoria = Vinculo::CONSTANTE;
+        v.valor = 1;
+        if (Nome n = nomes.procurar("true")) tabela.declarar(n, v);
+        v.valor = 0;
+        if (Nome n = nomes.procurar("false")) tabela.declarar(n, v);
+    }
+
+    //----------------------------------------------------------------------------
+    // Emissão
+    //----------------------------------------------------------------------------
+
+    int32_t enderecoAtual() const { return (int32_t)p->codigo.size(); }
+
+    // Emite uma instrução; 'ajuste' corrige o efeito na pilha das instruções de efeito variável.
+    void emitir(OpCodigo op, int32_t a = 0, int32_t b = 0, int32_t ajuste = 0) {
+        int32_t pc = enderecoAtual();
+        if (p->linhas.empty() || p->linhas.back().second != linhaAtual) {
+            if (!p->linhas.empty() && p->linhas.back().first == pc) p->linhas.back().second = linhaAtual;
+            else p->linhas.push_back({pc, linhaAtual});
+        }
+        const InfoOpCodigo& info = infoOpCodigo(op);
+        p->codigo.push_back((int32_t)op);
+        if (info.operandos >= 1) p->codigo.push_back(a);
+        if (info.operandos >= 2) p->codigo.push_back(b);
+        ultimaInstrucao = pc;
+        RotinaEmAndamento& r = atual();
+        r.altura += info.efeito + ajuste;
+        p->rotinas[r.indice].pilhaMaxima = max(p->rotinas[r.indice].pilhaMaxima, r.altura);
+    }
+
+    // Emite um desvio e devolve a posição do operando, para ser corrigido por marcarDestino.
+    int32_t emitirDesvio(OpCodigo op, int32_t destino = -1) {
+        emitir(op, destino);
+        return enderecoAtual() - 1;
+    }
+
+    void marcarDestino(int32_t operando) { p->codigo[operando] = enderecoAtual(); }
+
+    // Desvia se a condição que acabou de ser empilhada for igual a 'valor'. Uma comparação de
+    // inteiros logo antes vira um único desvio condicional.
+    int32_t emitirDesvioCondicional(bool valor, int32_t destino = -1) {
+        if (ultimaInstrucao >= 0 && ultimaInstrucao == enderecoAtual() - 1) {
+            OpCodigo anterior = (OpCodigo)p->codigo[ultimaInstrucao];
+            if (anterior >= OpCodigo::IGUAL_I && anterior <= OpCodigo::MAIOR_IGUAL_I) {
+                static const OpCodigo direto[] = {
+                    OpCodigo::SALTA_SE_IGUAL_I, OpCodigo::SALTA_SE_DIFERENTE_I, OpCodigo::SALTA_SE_MENOR_I,
+                    OpCodigo::SALTA_SE_MENOR_IGUAL_I, OpCodigo::SALTA_SE_MAIOR_I, OpCodigo::SALTA_SE_MAIOR_IGUAL_I
+                };
+                static const OpCodigo inverso[] = {
+                    OpCodigo::SALTA_SE_DIFERENTE_I, OpCodigo::SALTA_SE_IGUAL_I, OpCodigo::SALTA_SE_MAIOR_IGUAL_I,
+                    OpCodigo::SALTA_SE_MAIOR_I, OpCodigo::SALTA_SE_MENOR_IGUAL_I, OpCodigo::SALTA_SE_MENOR_I
+                };
+                size_t k = (size_t)anterior - (size_t)OpCodigo::IGUAL_I;
+                p->codigo.pop_back();
+                atual().altura += 1; // Desfaz o efeito da comparação
+                return emitirDesvio(valor ? direto[k] : inverso[k], destino);
+            }
+        }
+        return emitirDesvio(valor ? OpCodigo::SALTA_SE_VERDADEIRO : OpCodigo::SALTA_SE_FALSO, destino);
+    }
+
+    int32_t alocarSlots(int32_t quantidade) {
+        RotinaEmAndamento& r = atual();
+        int32_t slot = r.proximoSlot;
+        r.proximoSlot += quantidade;
+        r.slots = max(r.slots, r.proximoSlot);
+        return slot;
+    }
+
+    // Termina a rotina atual: corrige os 'goto' e fecha o tamanho do quadro.
+    void fecharRotina() {
+        RotinaEmAndamento& r = atual();
+        for (auto& [operando, noGoto] : r.pendentes) {
+            auto it = r.rotulos.find(noGoto->valor);
+            if (it == r.rotulos.end()) {
+                erro(noGoto->linha, "o rotulo '" + nomes.texto(noGoto->valor) + "' nao marca nenhum comando desta sub-rotina.");
+            } else {
+                p->codigo[operando] = it->second;
+            }
+        }
+        p->rotinas[r.indice].quadro = r.slots;
+        emAndamento.pop_back();
+    }
+
+    //----------------------------------------------------------------------------
+    // Declarações
+    //----------------------------------------------------------------------------
+
+    TipoDado tipoPrimitivo(Nome nome) const {
+        const string& t = nomes.texto(nome);
+        if (t == "integer") return TipoDado::INTEIRO;
+        if (t == "boolean") return TipoDado::BOOLEANO;
+        if (t == "real") return TipoDado::REAL;
+        if (t == "string") return TipoDado::STRING;
+        return TipoDado::INDEFINIDO;
+    }
+
+    TipoGerado resolverTipo(ASTNode* noTipo) {
+        TipoGerado t;
+        if (noTipo->tipo == TipoNo::TIPO_PRIMITIVO) {
+            t.tipo = tipoPrimitivo(noTipo->valor);
+        } else if (noTipo->tipo == TipoNo::TIPO_IDENTIFICADOR) {
+            if (const Vinculo* v = tabela.buscar(noTipo->valor)) t = v->tipo;
+        } else if (noTipo->tipo == TipoNo::TIPO_ARRAY) {
+            long long inicio = strtoll(nomes.texto(noTipo->filhos[0]->valor).c_str(), nullptr, 10);
+            long long fim = strtoll(nomes.texto(noTipo->filhos[1]->valor).c_str(), nullptr, 10);
+            t.tipo = TipoDado::ARRAY;
+            t.elemento = resolverTipo(noTipo->filhos[2]).tipo;
+            if (fim - inicio + 1 > (1 << 24) || inicio < INT32_MIN || fim > INT32_MAX) {
+                erro(noTipo->linha, "array grande demais para a maquina virtual.");
+                fim = inicio;
+            }
+            t.inicio = (int32_t)inicio;
+            t.tamanho = (int32_t)(fim - inicio + 1);
+        }
+        return t;
+    }
+
+    void gerarBloco(ASTNode* noBloco) {
+        tabela.entrarEscopo();
+        bool temComandos = false;
+        for (ASTNode* filho : noBloco->filhos) {
+            switch (filho->tipo) {
+                case TipoNo::DECLARACAO_TIPOS:
+                    for (ASTNode* decl : filho->filhos) {
+                        Vinculo v;
+                        v.categoria = Vinculo::TIPO;
+                        v.tipo = resolverTipo(decl->filhos[0]);
+                        tabela.declarar(decl->valor, v);
+                    }
+                    break;
+                case TipoNo::DECLARACAO_VARIAVEIS:
+                    for (ASTNode* decl : filho->filhos) {
+                        TipoGerado tipo = resolverTipo(decl->filhos[1]);
+                        for (ASTNode* id : decl->filhos[0]->filhos) declararVariavel(id->valor, tipo, false);
+                    }
+                    break;
+                case TipoNo::FUNCAO:
+                case TipoNo::PROCEDIMENTO:
+                    gerarRotina(filho);
+                    break;
+                case TipoNo::LISTA_COMANDOS:
+                    p->rotinas[atual().indice].inicio = enderecoAtual(); // As sub-rotinas vêm antes
+                    temComandos = true;
+                    gerarComando(filho);
+                    break;
+                default: // Rótulos: os endereços são marcados nos comandos
+                    break;
+            }
+        }
+        if (!temComandos) p->rotinas[atual().indice].inicio = enderecoAtual();
+        tabela.sairEscopo();
+    }
+
+    void declararVariavel(Nome nome, const TipoGerado& tipo, bool porReferencia) {
+        Vinculo v;
+        v.categoria = porReferencia ? Vinculo::REFERENCIA : Vinculo::VARIAVEL;
+        v.tipo = tipo;
+        v.nivel = atual().nivel;
+        v.slot = alocarSlots(porReferencia ? 1 : tipo.slots());
+        tabela.declarar(nome, v);
+    }
+
+    // Função ou procedimento: o código da sub-rotina fica inteiro antes do código de quem a declara.
+    void gerarRotina(ASTNode* no) {
+        bool ehFuncao = no->tipo == TipoNo::FUNCAO;
+        int32_t indice = (int32_t)p->rotinas.size();
+        p->rotinas.push_back({});
+        p->rotinas[indice].nome = nomes.texto(no->valor);
+        p->rotinas[indice].nivel = atual().nivel + 1;
+
+        vector<ParametroGerado> parametros;
+        ASTNode* noParams = no->filhos[0];
+        if (noParams->tipo == TipoNo::LISTA_PARAMETROS) {
+            for (ASTNode* grupo : noParams->filhos) {
+                ParametroGerado parametro = {resolverTipo(grupo->filhos[1]), grupo->tipo == TipoNo::GRUPO_PARAMETRO_REF};
+                parametros.insert(parametros.end(), grupo->filhos[0]->filhos.size(), parametro);
+            }
+        }
+        assinaturas.push_back(parametros);
+
+        Vinculo v;
+        v.categoria = Vinculo::ROTINA;
+        v.rotina = indice;
+        tabela.declarar(no->valor, v); // Antes do corpo: chamadas recursivas
+
+        int linhaAnterior = linhaAtual;
+        emAndamento.emplace_back(indice, p->rotinas[indice].nivel);
+        tabela.entrarEscopo();
+        size_t k = 0;
+        if (noParams->tipo == TipoNo::LISTA_PARAMETROS) {
+            for (ASTNode* grupo : noParams->filhos) {
+                for (ASTNode* id : grupo->filhos[0]->filhos) {
+                    declararVariavel(id->valor, parametros[k].tipo, parametros[k].porReferencia);
+                    ++k;
+                }
+            }
+        }
+        p->rotinas[indice].parametros = atual().proximoSlot;
+        resultadoDe.resize(indice + 1, -1);
+        if (ehFuncao) resultadoDe[indice] = alocarSlots(1);
+
+        gerarBloco(no->filhos[no->filhos.size() - 1]);
+        linhaAtual = no->linha;
+        if (ehFuncao) emitir(OpCodigo::RETORNA_VALOR, resultadoDe[indice]);
+        else emitir(OpCodigo::RETORNA);
+        tabela.sairEscopo();
+        fecharRotina();
+        linhaAtual = linhaAnterior;
+    }
+
+    //----------------------------------------------------------------------------
+    // Variáveis
+    //----------------------------------------------------------------------------
+
+    // Instrução LOCAL, GLOBAL ou EXTERNO para uma variável do nível 'nivel'.
+    void emitirAcesso(OpCodigo local, OpCodigo global, OpCodigo externo, int32_t nivel, int32_t slot) {
+        int32_t saltos = atual().nivel - nivel;
+        if (saltos == 0) emitir(local, slot);
+        else if (nivel == 0) emitir(global, slot);
+        else emitir(externo, saltos, slot);
+    }
+
+    void carregar(int32_t nivel, int32_t slot) {
+        emitirAcesso(OpCodigo::CARREGA_LOCAL, OpCodigo::CARREGA_GLOBAL, OpCodigo::CARREGA_EXTERNO, nivel, slot);
+    }
+
+    void armazenar(int32_t nivel, int32_t slot) {
+        emitirAcesso(OpCodigo::ARMAZENA_LOCAL, OpCodigo::ARMAZENA_GLOBAL, OpCodigo::ARMAZENA_EXTERNO, nivel, slot);
+    }
+
+    const Vinculo& vinculo(ASTNode* no) {
+        static const Vinculo NENHUM;
+        const Vinculo* v = tabela.buscar(no->valor);
+        if (!v) {
+            erro(no->linha, "'" + nomes.texto(no->valor) + "' nao foi declarado.");
+            return NENHUM;
+        }
+        return *v;
+    }
+
+    // Tipo (com os limites, para arrays) da variável ou do elemento de array indicado pelo nó.
+    TipoGerado tipoDaVariavel(ASTNode* no) {
+        const Vinculo& v = vinculo(no);
+        if (no->tipo == TipoNo::IDENTIFICADOR) return v.tipo;
+        TipoGerado elemento;
+        elemento.tipo = v.tipo.elemento;
+        return elemento;
+    }
+
+    // Empilha o endereço de uma variável ou de um elemento de array.
+    void gerarEndereco(ASTNode* no) {
+        const Vinculo& v = vinculo(no);
+        if (v.categoria == Vinculo::REFERENCIA) {
+            carregar(v.nivel, v.slot); // O slot guarda o endereço
+        } else if (v.categoria == Vinculo::VARIAVEL) {
+            emitirAcesso(OpCodigo::ENDERECO_LOCAL, OpCodigo::ENDERECO_GLOBAL, OpCodigo::ENDERECO_EXTERNO, v.nivel, v.slot);
+        } else {
+            erro(no->linha, "'" + nomes.texto(no->valor) + "' nao e uma variavel.");
+            return;
+        }
+        if (no->tipo == TipoNo::ACESSO_ARRAY) {
+            gerarValor(no->filhos[1], TipoDado::INTEIRO);
+            emitir(OpCodigo::INDICE, v.tipo.inicio, v.tipo.tamanho);
+        }
+    }
+
+    // Atribuição de um valor de tipo escalar a uma variável, elemento de array ou valor de retorno.
+    void gerarAtribuicao(ASTNode* destino, ASTNode* expressao) {
+        const Vinculo& v = vinculo(destino);
+        TipoDado tipo = destino->tipoDado;
+        if (destino->tipo == TipoNo::IDENTIFICADOR && v.categoria == Vinculo::ROTINA) { // Valor de retorno
+            gerarValor(expressao, tipo);
+            armazenar(p->rotinas[v.rotina].nivel, resultadoDe[v.rotina]);
+            return;
+        }
+        if (tipo == TipoDado::ARRAY) { // Cópia do array inteiro
+            TipoGerado t = tipoDaVariavel(destino);
+            TipoGerado origem = tipoDaVariavel(expressao);
+            if (t.tamanho != origem.tamanho) {
+                erro(destino->linha, "atribuicao entre arrays de tamanhos diferentes.");
+                return;
+            }
+            gerarEndereco(destino);
+            gerarEndereco(expressao);
+            emitir(OpCodigo::COPIA_BLOCO, t.tamanho);
+            return;
+        }
+        if (destino->tipo == TipoNo::IDENTIFICADOR && v.categoria == Vinculo::VARIAVEL) {
+            gerarValor(expressao, tipo);
+            armazenar(v.nivel, v.slot);
+            return;
+        }
+        gerarEndereco(destino);
+        gerarValor(expressao, tipo);
+        emitir(OpCodigo::ARMAZENA_INDIRETO);
+    }
+
+    //----------------------------------------------------------------------------
+    // Comandos
+    //----------------------------------------------------------------------------
+
+    void gerarComando(ASTNode* no) {
+        linhaAtual = no->linha;
+        switch (no->tipo) {
+            case TipoNo::LISTA_COMANDOS:
+                for (ASTNode* filho : no->filhos) gerarComando(filho);
+                break;
+            case TipoNo::COMANDO_COM_ROTULO:
+                atual().rotulos[no->filhos[0]->valor] = enderecoAtual();
+                gerarComando(no->filhos[1]);
+                break;
+            case TipoNo::ATRIBUICAO:
+            case TipoNo::RETORNO_FUNCAO:
+                gerarAtribuicao(no->filhos[0], no->filhos[1]);
+                break;
+            case TipoNo::IF: {
+                gerarExpressao(no->filhos[0]);
+                int32_t senao = emitirDesvioCondicional(false);
+                gerarComando(no->filhos[1]);
+                if (no->filhos.size() > 2) {
+                    int32_t fim = emitirDesvio(OpCodigo::SALTA);
+                    marcarDestino(senao);
+                    gerarComando(no->filhos[2]);
+                    marcarDestino(fim);
+                } else {
+                    marcarDestino(senao);
+                }
+                break;
+            }
+            case TipoNo::WHILE: { // O teste fica no fim do laço: um desvio por volta
+                int32_t teste = emitirDesvio(OpCodigo::SALTA);
+                int32_t corpo = enderecoAtual();
+                gerarComando(no->filhos[1]);
+                marcarDestino(teste);
+                linhaAtual = no->linha;
+                gerarExpressao(no->filhos[0]);
+                emitirDesvioCondicional(true, corpo);
+                break;
+            }
+            case TipoNo::FOR:
+                gerarFor(no);
+                break;
+            case TipoNo::GOTO: {
+                RotinaEmAndamento& r = atual();
+                auto it = r.rotulos.find(no->valor);
+                if (it != r.rotulos.end()) emitirDesvio(OpCodigo::SALTA, it->second);
+                else r.pendentes.push_back({emitirDesvio(OpCodigo::SALTA), no});
+                break;
+            }
+            case TipoNo::CHAMADA_SUBROTINA:
+                if (gerarChamada(no)) emitir(OpCodigo::DESCARTA); // Função chamada como comando
+                break;
+            default:
+                erro(no->linha, string("comando '") + nomeTipoNo(no->tipo) + "' nao suportado.");
+        }
+    }
+
+    // for v := inicio to|downto fim do comando. O limite é calculado uma vez, antes do laço.
+    void gerarFor(ASTNode* no) {
+        ASTNode* controle = no->filhos[0];
+        bool crescente = nomes.texto(no->valor) == "to";
+        gerarAtribuicao(controle, no->filhos[1]);
+        int32_t limite = alocarSlots(1);
+        gerarValor(no->filhos[2], TipoDado::INTEIRO);
+        emitir(OpCodigo::ARMAZENA_LOCAL, limite);
+
+        int32_t teste = emitirDesvio(OpCodigo::SALTA);
+        int32_t corpo = enderecoAtual();
+        gerarComando(no->filhos[3]);
+        linhaAtual = no->linha;
+        const Vinculo& v = vinculo(controle);
+        if (v.categoria == Vinculo::VARIAVEL && v.nivel == atual().nivel) {
+            emitir(OpCodigo::INCREMENTA_LOCAL, v.slot, crescente ? 1 : -1);
+        } else {
+            gerarAtribuicaoIncremento(controle, crescente ? 1 : -1);
+        }
+        marcarDestino(teste);
+        gerarExpressao(controle);
+        emitir(OpCodigo::CARREGA_LOCAL, limite);
+        emitirDesvio(crescente ? OpCodigo::SALTA_SE_MENOR_IGUAL_I : OpCodigo::SALTA_SE_MAIOR_IGUAL_I, corpo);
+        atual().proximoSlot--; // O temporário do limite pode ser reaproveitado
+    }
+
+    // controle := controle + passo, para variáveis que não estão no quadro atual.
+    void gerarAtribuicaoIncremento(ASTNode* controle, int32_t passo) {
+        const Vinculo& v = vinculo(controle);
+        if (v.categoria == Vinculo::VARIAVEL) {
+            carregar(v.nivel, v.slot);
+            emitir(OpCodigo::SOMA_IMEDIATO, passo);
+            armazenar(v.nivel, v.slot);
+        } else {
+            gerarEndereco(controle);
+            gerarEndereco(controle);
+            emitir(OpCodigo::CARREGA_INDIRETO);
+            emitir(OpCodigo::SOMA_IMEDIATO, passo);
+            emitir(OpCodigo::ARMAZENA_INDIRETO);
+        }
+    }
+
+    // Chamada de sub-rotina (ou de read/write). Devolve true se deixou um valor na pilha.
+    bool gerarChamada(ASTNode* no) {
+        const Vinculo& v = vinculo(no);
+        ASTNode* args = no->filhos.empty() ? nullptr : no->filhos[0];
+        size_t quantidade = args ? args->filhos.size() : 0;
+
+        if (v.categoria == Vinculo::LEITURA) {
+            for (size_t i = 0; i < quantidade; ++i) {
+                ASTNode* arg = args->filhos[i];
+                gerarEndereco(arg);
+                emitir(porTipo(arg->tipoDado, OpCodigo::LE_I, OpCodigo::LE_R, OpCodigo::LE_B, OpCodigo::LE_T, arg));
+            }
+            return false;
+        }
+        if (v.categoria == Vinculo::ESCRITA) {
+            for (size_t i = 0; i < quantidade; ++i) {
+                ASTNode* arg = args->filhos[i];
+                gerarExpressao(arg);
+                emitir(porTipo(arg->tipoDado, OpCodigo::ESCREVE_I, OpCodigo::ESCREVE_R, OpCodigo::ESCREVE_B, OpCodigo::ESCREVE_T, arg));
+            }
+            emitir(OpCodigo::ESCREVE_FIM_LINHA);
+            return false;
+        }
+        if (v.categoria != Vinculo::ROTINA) {
+            erro(no->linha, "'" + nomes.texto(no->valor) + "' nao e uma funcao nem um procedimento.");
+            return false;
+        }
+
+        const vector<ParametroGerado>& parametros = assinaturas[v.rotina];
+        for (size_t i = 0; i < quantidade && i < parametros.size(); ++i) {
+            ASTNode* arg = args->filhos[i];
+            const ParametroGerado& parametro = parametros[i];
+            if (parametro.tipo.tipo == TipoDado::ARRAY && tipoDaVariavel(arg).tamanho != parametro.tipo.tamanho) {
+                erro(arg->linha, "array de tamanho diferente do parametro " + to_string(i + 1) + " de '" + nomes.texto(no->valor) + "'.");
+            }
+            if (parametro.porReferencia) {
+                gerarEndereco(arg);
+            } else if (parametro.tipo.tipo == TipoDado::ARRAY) {
+                gerarEndereco(arg);
+                emitir(OpCodigo::EMPILHA_BLOCO, parametro.tipo.tamanho, 0, parametro.tipo.tamanho - 1);
+            } else {
+                gerarValor(arg, parametro.tipo.tipo);
+            }
+        }
+        const Rotina& rotina = p->rotinas[v.rotina];
+        bool devolveValor = resultadoDe[v.rotina] >= 0;
+        int32_t saltos = atual().nivel - (rotina.nivel - 1); // Até o quadro de quem declarou a rotina
+        emitir(OpCodigo::CHAMA, v.rotina, saltos, -rotina.parametros + (devolveValor ? 1 : 0));
+        return devolveValor;
+    }
+
+    OpCodigo porTipo(TipoDado tipo, OpCodigo i, OpCodigo r, OpCodigo b, OpCodigo t, ASTNode* no) {
+        switch (tipo) {
+            case TipoDado::INTEIRO: return i;
+            case TipoDado::REAL: return r;
+            case TipoDado::BOOLEANO: return b;
+            case TipoDado::STRING: return t;
+            default:
+                erro(no->linha, string("valor do tipo '") + nomeTipoDado(tipo) + "' nao pode ser lido nem escrito.");
+                return i;
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Expressões
+    //----------------------------------------------------------------------------
+
+    // Empilha o valor da expressão convertido para 'tipo' (integer -> real).
+    void gerarValor(ASTNode* no, TipoDado tipo) {
+        gerarExpressao(no);
+        if (tipo == TipoDado::REAL && no->tipoDado == TipoDado::INTEIRO) emitir(OpCodigo::INT_PARA_REAL);
+    }
+
+    int32_t indiceDeTexto(const string& lexema) {
+        string texto;
+        for (size_t i = 1; i + 1 < lexema.size(); ++i) { // Sem as aspas; '' vira '
+            texto += lexema[i];
+            if (lexema[i] == '\'') ++i;
+        }
+        auto it = indiceTexto.find(texto);
+        if (it != indiceTexto.end()) return it->second;
+        p->textos.push_back(texto);
+        indiceTexto.emplace(texto, (int32_t)p->textos.size() - 1);
+        return (int32_t)p->textos.size() - 1;
+    }
+
+    void empilharConstante(Valor valor, bool real) {
+        p->constantes.push_back(valor);
+        p->constanteReal.push_back(real);
+        emitir(OpCodigo::EMPILHA_CONST, (int32_t)p->constantes.size() - 1);
+    }
+
+    void gerarExpressao(ASTNode* no) {
+        switch (no->tipo) {
+            case TipoNo::NUMERO: {
+                const string& texto = nomes.texto(no->valor);
+                if (no->tipoDado == TipoDado::REAL) {
+                    Valor v;
+                    v.r = strtod(texto.c_str(), nullptr);
+                    empilharConstante(v, true);
+                } else {
+                    long long n = strtoll(texto.c_str(), nullptr, 10);
+                    if (n >= INT32_MIN && n <= INT32_MAX) {
+                        emitir(OpCodigo::EMPILHA_INT, (int32_t)n);
+                    } else {
+                        Valor v;
+                        v.i = n;
+                        empilharConstante(v, false);
+                    }
+                }
+                break;
+            }
+            case TipoNo::STRING:
+                emitir(OpCodigo::EMPILHA_TEXTO, indiceDeTexto(nomes.texto(no->valor)));
+                break;
+            case TipoNo::IDENTIFICADOR: {
+                const Vinculo& v = vinculo(no);
+                if (v.categoria == Vinculo::VARIAVEL) carregar(v.nivel, v.slot);
+                else if (v.categoria == Vinculo::REFERENCIA) {
+                    carregar(v.nivel, v.slot);
+                    emitir(OpCodigo::CARREGA_INDIRETO);
+                } else if (v.categoria == Vinculo::CONSTANTE) emitir(OpCodigo::EMPILHA_INT, (int32_t)v.valor);
+                else if (v.categoria == Vinculo::ROTINA) gerarChamada(no); // Função sem argumentos
+                else erro(no->linha, "'" + nomes.texto(no->valor) + "' nao pode ser usado em uma expressao.");
+                break;
+            }
+            case TipoNo::ACESSO_ARRAY:
+                gerarEndereco(no);
+                emitir(OpCodigo::CARREGA_INDIRETO);
+                break;
+            case TipoNo::CHAMADA_SUBROTINA:
+                gerarChamada(no);
+                break;
+            case TipoNo::OPERADOR_UNARIO: {
+                Operador op = operadorDoNome(no->valor);
+                gerarExpressao(no->filhos[0]);
+                if (op == Operador::NOT) emitir(no->tipoDado == TipoDado::BOOLEANO ? OpCodigo::NAO : OpCodigo::NAO_BIT_I);
+                else if (op == Operador::SUBTRACAO) emitir(no->tipoDado == TipoDado::REAL ? OpCodigo::NEGA_R : OpCodigo::NEGA_I);
+                break;
+            }
+            case TipoNo::OPERADOR_BINARIO:
+                gerarOperadorBinario(no);
+                break;
+            default:
+                erro(no->linha, string("expressao '") + nomeTipoNo(no->tipo) + "' nao suportada.");
+        }
+    }
+
+    void gerarOperadorBinario(ASTNode* no) {
+        Operador op = operadorDoNome(no->valor);
+        ASTNode* esq = no->filhos[0];
+        ASTNode* dir = no->filhos[1];
+        TipoDado te = esq->tipoDado, td = dir->tipoDado;
+
+        if (op == Operador::SOMA && te == TipoDado::STRING) {
+            gerarExpressao(esq);
+            gerarExpressao(dir);
+            emitir(OpCodigo::CONCATENA);
+            return;
+        }
+        if (op == Operador::AND || op == Operador::OR) {
+            gerarExpressao(esq);
+            gerarExpressao(dir);
+            emitir(op == Operador::AND ? OpCodigo::E : OpCodigo::OU);
+            return;
+        }
+
+        // Os relacionais estão na mesma ordem em Operador e nas instruções de comparação.
+        if (op >= Operador::IGUAL && op <= Operador::MAIOR_IGUAL) {
+            size_t k = (size_t)op - (size_t)Operador::IGUAL;
+            OpCodigo base = OpCodigo::IGUAL_I;
+            TipoDado operandos = TipoDado::INTEIRO;
+            if (te == TipoDado::REAL || td == TipoDado::REAL) {
+                base = OpCodigo::IGUAL_R;
+                operandos = TipoDado::REAL;
+            } else if (te == TipoDado::STRING) {
+                base = OpCodigo::IGUAL_T;
+            }
+            gerarValor(esq, operandos);
+            gerarValor(dir, operandos);
+            emitir((OpCodigo)((size_t)base + k));
+            return;
+        }
+
+        // Aritméticos: o tipo do resultado decide as instruções; '/' é sempre real.
+        bool real = no->tipoDado == TipoDado::REAL;
+        gerarValor(esq, no->tipoDado);
+        if (!real && (op == Operador::SOMA || op == Operador::SUBTRACAO) && dir->tipo == TipoNo::NUMERO) { // x + constante
+            long long n = strtoll(nomes.texto(dir->valor).c_str(), nullptr, 10);
+            if (n > INT32_MIN && n <= INT32_MAX) {
+                emitir(OpCodigo::SOMA_IMEDIATO, (int32_t)(op == Operador::SOMA ? n : -n));
+                return;
+            }
+        }
+        gerarValor(dir, no->tipoDado);
+        switch (op) {
+            case Operador::SOMA: emitir(real ? OpCodigo::SOMA_R : OpCodigo::SOMA_I); break;
+            case Operador::SUBTRACAO: emitir(real ? OpCodigo::SUBTRAI_R : OpCodigo::SUBTRAI_I); break;
+            case Operador::MULTIPLICACAO: emitir(real ? OpCodigo::MULTIPLICA_R : OpCodigo::MULTIPLICA_I); break;
+            case Operador::DIVISAO: emitir(OpCodigo::DIVIDE_R); break;
+            case Operador::DIV: emitir(OpCodigo::DIV_I); break;
+            case Operador::MOD: emitir(OpCodigo::MOD_I); break;
+            default: erro(no->linha, "operador '" + nomes.texto(no->valor) + "' nao suportado.");
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,421 @@
+#ifndef MAQUINA_VIRTUAL_H
+#define MAQUINA_VIRTUAL_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+#include "Bytecode.h"
+
+using namespace std;
+
+// Máquina de pilha que executa o ProgramaBytecode gerado por GeradorBytecode.h.
+//
+// Uma única pilha de Valor guarda os quadros das sub-rotinas e, acima de cada quadro, os
+// operandos. Endereços são posições nessa pilha, então parâmetros 'var' e elementos de array
+// usam as mesmas instruções de carga e armazenamento indiretos. Cada chamada guarda a ligação
+// estática (o quadro de quem declarou a sub-rotina), usada pelas instruções EXTERNO.
+//
+// Uma string na pilha é o índice de um literal do programa ou, para as criadas na execução
+// (concatenação e read), MARCA_DINAMICO mais a posição dela em 'dinamicos'. As que nenhuma
+// posição da pilha referencia mais são liberadas por uma coleta (ver coletarTextos).
+//
+// O despacho usa 'goto' computado (um desvio indireto por instrução, cada um previsto
+// separadamente pelo processador) quando o compilador tem essa extensão; com
+// -DMAQUINA_DESPACHO_SWITCH, ou em outros compiladores, usa um switch dentro de um laço.
+#if defined(__GNUC__) && !defined(MAQUINA_DESPACHO_SWITCH)
+#define MAQUINA_DESPACHO_COMPUTADO 1
+#endif
+
+struct ResultadoExecucao {
+    bool ok = true;
+    string erro;              // "Erro de execucao na linha N: ..." quando !ok
+    uint64_t instrucoes = 0;  // Instruções executadas
+};
+
+class MaquinaVirtual {
+public:
+    static constexpr size_t MAX_CHAMADAS = 1'000'000; // Chamadas aninhadas
+
+    MaquinaVirtual(const ProgramaBytecode& programaExecutado, istream& entradaDados, ostream& saidaDados,
+                   size_t tamanhoPilha = 1 << 20)
+        : programa(programaExecutado), entrada(entradaDados), saida(saidaDados), pilha(tamanhoPilha),
+          limiteColeta(LIMIAR_COLETA) {}
+
+    ResultadoExecucao executar() {
+        ResultadoExecucao resultado;
+        const int32_t* const codigo = programa.codigo.data();
+        const Rotina* const rotinas = programa.rotinas.data();
+        Valor* const inicioPilha = pilha.data();
+        Valor* const fimPilha = inicioPilha + pilha.size();
+        string mensagem;
+
+        const Rotina& principal = rotinas[0];
+        if ((size_t)principal.quadro + principal.pilhaMaxima > pilha.size()) {
+            return {false, "Erro de execucao: as variaveis globais nao cabem na pilha.", 0};
+        }
+        memset(inicioPilha, 0, sizeof(Valor) * principal.quadro);
+        quadros.clear();
+        quadros.push_back({nullptr, inicioPilha, -1});
+        dinamicos.clear();
+        estadoTexto.clear();
+        livres.clear();
+        bytesDesdeColeta = 0;
+        limiteColeta = LIMIAR_COLETA;
+
+        const int32_t* ip = codigo + principal.inicio;
+        Valor* base = inicioPilha;               // Quadro atual
+        Valor* sp = inicioPilha + principal.quadro; // Próxima posição livre
+        int32_t quadroAtual = 0;
+        uint64_t executadas = 0;
+
+// Lê o próximo operando da instrução.
+#define OPERANDO() (*ip++)
+// Falha na instrução atual: ip já passou do código da instrução, então ip - 1 ainda está nela.
+#define FALHA(texto)          \
+    do {                      \
+        mensagem = (texto);   \
+        goto falha;           \
+    } while (0)
+
+#ifdef MAQUINA_DESPACHO_COMPUTADO
+        static void* const despacho[] = {
+#define X_ROTULO(nome, operandos, efeito) &&OP_##nome,
+            OPCODES(X_ROTULO)
+#undef X_ROTULO
+        };
+#define INSTRUCAO(nome) OP_##nome:
+#define PROXIMA()                        \
+    do {                                 \
+        ++executadas;                    \
+        goto *despacho[*ip++];           \
+    } while (0)
+        PROXIMA();
+        {
+#else
+#define INSTRUCAO(nome) case OpCodigo::nome:
+#define PROXIMA() continue
+        for (;;) {
+            ++executadas;
+            switch ((OpCodigo)*ip++) {
+#endif
+
+        INSTRUCAO(EMPILHA_INT) { (sp++)->i = OPERANDO(); PROXIMA(); }
+        INSTRUCAO(EMPILHA_CONST) { *sp++ = programa.constantes[OPERANDO()]; PROXIMA(); }
+        INSTRUCAO(EMPILHA_TEXTO) { (sp++)->i = OPERANDO(); PROXIMA(); }
+        INSTRUCAO(DESCARTA) { --sp; PROXIMA(); }
+
+        INSTRUCAO(CARREGA_LOCAL) { *sp++ = base[OPERANDO()]; PROXIMA(); }
+        INSTRUCAO(ARMAZENA_LOCAL) { base[OPERANDO()] = *--sp; PROXIMA(); }
+        INSTRUCAO(CARREGA_GLOBAL) { *sp++ = inicioPilha[OPERANDO()]; PROXIMA(); }
+        INSTRUCAO(ARMAZENA_GLOBAL) { inicioPilha[OPERANDO()] = *--sp; PROXIMA(); }
+        INSTRUCAO(CARREGA_EXTERNO) {
+            Valor* externo = quadroExterno(quadroAtual, OPERANDO());
+            *sp++ = externo[OPERANDO()];
+            PROXIMA();
+        }
+        INSTRUCAO(ARMAZENA_EXTERNO) {
+            Valor* externo = quadroExterno(quadroAtual, OPERANDO());
+            externo[OPERANDO()] = *--sp;
+            PROXIMA();
+        }
+        INSTRUCAO(ENDERECO_LOCAL) { (sp++)->i = base - inicioPilha + OPERANDO(); PROXIMA(); }
+        INSTRUCAO(ENDERECO_GLOBAL) { (sp++)->i = OPERANDO(); PROXIMA(); }
+        INSTRUCAO(ENDERECO_EXTERNO) {
+            Valor* externo = quadroExterno(quadroAtual, OPERANDO());
+            (sp++)->i = externo - inicioPilha + OPERANDO();
+            PROXIMA();
+        }
+        INSTRUCAO(CARREGA_INDIRETO) { sp[-1] = inicioPilha[sp[-1].i]; PROXIMA(); }
+        INSTRUCAO(ARMAZENA_INDIRETO) {
+            sp -= 2;
+            inicioPilha[sp[0].i] = sp[1];
+            PROXIMA();
+        }
+        INSTRUCAO(INDICE) {
+            int32_t inicio = OPERANDO();
+            int32_t tamanho = OPERANDO();
+            int64_t indice = (--sp)->i;
+            uint64_t deslocamento = (uint64_t)indice - (uint64_t)inicio;
+            if (deslocamento >= (uint64_t)tamanho) {
+                FALHA("indice " + to_string(indice) + " fora dos limites do array [" + to_string(inicio) + ".."
+                      + to_string((int64_t)inicio + tamanho - 1) + "].");
+            }
+            sp[-1].i += (int64_t)deslocamento;
+            PROXIMA();
+        }
+        INSTRUCAO(EMPILHA_BLOCO) {
+            int32_t tamanho = OPERANDO();
+            Valor* origem = inicioPilha + (--sp)->i;
+            memmove(sp, origem, sizeof(Valor) * tamanho);
+            sp += tamanho;
+            PROXIMA();
+        }
+        INSTRUCAO(COPIA_BLOCO) {
+            int32_t tamanho = OPERANDO();
+            sp -= 2;
+            memmove(inicioPilha + sp[0].i, inicioPilha + sp[1].i, sizeof(Valor) * tamanho);
+            PROXIMA();
+        }
+        INSTRUCAO(INCREMENTA_LOCAL) {
+            Valor& v = base[OPERANDO()];
+            v.i = (int64_t)((uint64_t)v.i + (uint64_t)(int64_t)OPERANDO());
+            PROXIMA();
+        }
+
+        // Inteiros: a aritmética dá a volta (complemento de 2) em vez de ter comportamento indefinido.
+        INSTRUCAO(SOMA_I) { --sp; sp[-1].i = (int64_t)((uint64_t)sp[-1].i + (uint64_t)sp[0].i); PROXIMA(); }
+        INSTRUCAO(SUBTRAI_I) { --sp; sp[-1].i = (int64_t)((uint64_t)sp[-1].i - (uint64_t)sp[0].i); PROXIMA(); }
+        INSTRUCAO(MULTIPLICA_I) { --sp; sp[-1].i = (int64_t)((uint64_t)sp[-1].i * (uint64_t)sp[0].i); PROXIMA(); }
+        INSTRUCAO(DIV_I) {
+            --sp;
+            if (sp[0].i == 0) FALHA("divisao por zero.");
+            sp[-1].i = sp[0].i == -1 ? (int64_t)(0 - (uint64_t)sp[-1].i) : sp[-1].i / sp[0].i;
+            PROXIMA();
+        }
+        INSTRUCAO(MOD_I) {
+            --sp;
+            if (sp[0].i == 0) FALHA("divisao por zero.");
+            sp[-1].i = sp[0].i == -1 ? 0 : sp[-1].i % sp[0].i;
+            PROXIMA();
+        }
+        INSTRUCAO(NEGA_I) { sp[-1].i = (int64_t)(0 - (uint64_t)sp[-1].i); PROXIMA(); }
+        INSTRUCAO(NAO_BIT_I) { sp[-1].i = ~sp[-1].i; PROXIMA(); }
+        INSTRUCAO(SOMA_IMEDIATO) {
+            sp[-1].i = (int64_t)((uint64_t)sp[-1].i + (uint64_t)(int64_t)OPERANDO());
+            PROXIMA();
+        }
+
+        INSTRUCAO(SOMA_R) { --sp; sp[-1].r += sp[0].r; PROXIMA(); }
+        INSTRUCAO(SUBTRAI_R) { --sp; sp[-1].r -= sp[0].r; PROXIMA(); }
+        INSTRUCAO(MULTIPLICA_R) { --sp; sp[-1].r *= sp[0].r; PROXIMA(); }
+        INSTRUCAO(DIVIDE_R) {
+            --sp;
+            if (sp[0].r == 0.0) FALHA("divisao por zero.");
+            sp[-1].r /= sp[0].r;
+            PROXIMA();
+        }
+        INSTRUCAO(NEGA_R) { sp[-1].r = -sp[-1].r; PROXIMA(); }
+        INSTRUCAO(INT_PARA_REAL) { sp[-1].r = (double)sp[-1].i; PROXIMA(); }
+        INSTRUCAO(CONCATENA) {
+            --sp;
+            string juntos = texto(sp[-1].i) + texto(sp[0].i);
+            sp[-1].i = novoTexto(move(juntos), inicioPilha, sp);
+            PROXIMA();
+        }
+
+#define COMPARACAO(nome, campo, op)                      \
+        INSTRUCAO(nome) {                                \
+            --sp;                                        \
+            sp[-1].i = sp[-1].campo op sp[0].campo;      \
+            PROXIMA();                                   \
+        }
+#define COMPARACAO_TEXTO(nome, op)                                   \
+        INSTRUCAO(nome) {                                            \
+            --sp;                                                    \
+            sp[-1].i = texto(sp[-1].i) op texto(sp[0].i);            \
+            PROXIMA();                                               \
+        }
+        COMPARACAO(IGUAL_I, i, ==) COMPARACAO(DIFERENTE_I, i, !=) COMPARACAO(MENOR_I, i, <)
+        COMPARACAO(MENOR_IGUAL_I, i, <=) COMPARACAO(MAIOR_I, i, >) COMPARACAO(MAIOR_IGUAL_I, i, >=)
+        COMPARACAO(IGUAL_R, r, ==) COMPARACAO(DIFERENTE_R, r, !=) COMPARACAO(MENOR_R, r, <)
+        COMPARACAO(MENOR_IGUAL_R, r, <=) COMPARACAO(MAIOR_R, r, >) COMPARACAO(MAIOR_IGUAL_R, r, >=)
+        COMPARACAO_TEXTO(IGUAL_T, ==) COMPARACAO_TEXTO(DIFERENTE_T, !=) COMPARACAO_TEXTO(MENOR_T, <)
+        COMPARACAO_TEXTO(MENOR_IGUAL_T, <=) COMPARACAO_TEXTO(MAIOR_T, >) COMPARACAO_TEXTO(MAIOR_IGUAL_T, >=)
+#undef COMPARACAO
+#undef COMPARACAO_TEXTO
+
+        // 'and' e 'or' valem para boolean (0 ou 1) e, bit a bit, para integer.
+        INSTRUCAO(E) { --sp; sp[-1].i &= sp[0].i; PROXIMA(); }
+        INSTRUCAO(OU) { --sp; sp[-1].i |= sp[0].i; PROXIMA(); }
+        INSTRUCAO(NAO) { sp[-1].i ^= 1; PROXIMA(); }
+
+        INSTRUCAO(SALTA) { ip = codigo + *ip; PROXIMA(); }
+        INSTRUCAO(SALTA_SE_FALSO) { ip = (--sp)->i ? ip + 1 : codigo + *ip; PROXIMA(); }
+        INSTRUCAO(SALTA_SE_VERDADEIRO) { ip = (--sp)->i ? codigo + *ip : ip + 1; PROXIMA(); }
+
+#define SALTO_COMPARADO(nome, op)                                \
+        INSTRUCAO(nome) {                                        \
+            sp -= 2;                                             \
+            ip = sp[0].i op sp[1].i ? codigo + *ip : ip + 1;     \
+            PROXIMA();                                           \
+        }
+        SALTO_COMPARADO(SALTA_SE_IGUAL_I, ==) SALTO_COMPARADO(SALTA_SE_DIFERENTE_I, !=)
+        SALTO_COMPARADO(SALTA_SE_MENOR_I, <) SALTO_COMPARADO(SALTA_SE_MENOR_IGUAL_I, <=)
+        SALTO_COMPARADO(SALTA_SE_MAIOR_I, >) SALTO_COMPARADO(SALTA_SE_MAIOR_IGUAL_I, >=)
+#undef SALTO_COMPARADO
+
+        INSTRUCAO(CHAMA) {
+            const Rotina& rotina = rotinas[OPERANDO()];
+            int32_t ligacao = quadroAtual;
+            for (int32_t saltos = OPERANDO(); saltos > 0; --saltos) ligacao = quadros[ligacao].ligacao;
+            if (quadros.size() >= MAX_CHAMADAS) FALHA("chamadas aninhadas demais (recursao infinita?).");
+            Valor* novoQuadro = sp - rotina.parametros;
+            if (fimPilha - novoQuadro < (ptrdiff_t)rotina.quadro + rotina.pilhaMaxima) {
+                FALHA("estouro da pilha na chamada de '" + rotina.nome + "'.");
+            }
+            memset(sp, 0, sizeof(Valor) * (rotina.quadro - rotina.parametros)); // Locais começam zerados
+            quadros.push_back({ip, novoQuadro, ligacao});
+            quadroAtual = (int32_t)quadros.size() - 1;
+            base = novoQuadro;
+            sp = base + rotina.quadro;
+            ip = codigo + rotina.inicio;
+            PROXIMA();
+        }
+        INSTRUCAO(RETORNA) {
+            sp = base;
+            ip = quadros.back().retorno;
+            quadros.pop_back();
+            quadroAtual = (int32_t)quadros.size() - 1;
+            base = quadros.back().base;
+            PROXIMA();
+        }
+        INSTRUCAO(RETORNA_VALOR) {
+            Valor valor = base[*ip];
+            sp = base;
+            *sp++ = valor;
+            ip = quadros.back().retorno;
+            quadros.pop_back();
+            quadroAtual = (int32_t)quadros.size() - 1;
+            base = quadros.back().base;
+            PROXIMA();
+        }
+
+        INSTRUCAO(LE_I) {
+            int64_t v;
+            if (!(entrada >> v)) FALHA("entrada invalida para 'read': esperado integer.");
+            inicioPilha[(--sp)->i].i = v;
+            PROXIMA();
+        }
+        INSTRUCAO(LE_R) {
+            double v;
+            if (!(entrada >> v)) FALHA("entrada invalida para 'read': esperado real.");
+            inicioPilha[(--sp)->i].r = v;
+            PROXIMA();
+        }
+        INSTRUCAO(LE_B) {
+            string v;
+            if (!(entrada >> v) || (v != "true" && v != "false")) FALHA("entrada invalida para 'read': esperado true ou false.");
+            inicioPilha[(--sp)->i].i = v == "true";
+            PROXIMA();
+        }
+        INSTRUCAO(LE_T) { // Uma palavra
+            string v;
+            if (!(entrada >> v)) FALHA("entrada invalida para 'read': fim da entrada.");
+            Valor* destino = inicioPilha + (--sp)->i;
+            destino->i = novoTexto(move(v), inicioPilha, sp);
+            PROXIMA();
+        }
+        INSTRUCAO(ESCREVE_I) { saida << (--sp)->i; PROXIMA(); }
+        INSTRUCAO(ESCREVE_R) { saida << (--sp)->r; PROXIMA(); }
+        INSTRUCAO(ESCREVE_B) { saida << ((--sp)->i ? "true" : "false"); PROXIMA(); }
+        INSTRUCAO(ESCREVE_T) { saida << texto((--sp)->i); PROXIMA(); }
+        INSTRUCAO(ESCREVE_FIM_LINHA) { saida << '\n'; PROXIMA(); }
+
+        INSTRUCAO(PARA) { goto fim; }
+
+#ifdef MAQUINA_DESPACHO_COMPUTADO
+        }
+#else
+                default:
+                    FALHA("instrucao invalida.");
+            }
+        }
+#endif
+
+#undef INSTRUCAO
+#undef PROXIMA
+#undef OPERANDO
+#undef FALHA
+
+    falha:
+        resultado.ok = false;
+        resultado.erro = "Erro de execucao na linha " + to_string(programa.linhaDe((int32_t)(ip - codigo - 1))) + ": " + mensagem;
+    fim:
+        saida.flush();
+        resultado.instrucoes = executadas;
+        return resultado;
+    }
+
+private:
+    struct Quadro {
+        const int32_t* retorno; // Próxima instrução de quem chamou
+        Valor* base;
+        int32_t ligacao;        // Índice do quadro de quem declarou a sub-rotina (ligação estática)
+    };
+
+    const ProgramaBytecode& programa;
+    istream& entrada;
+    ostream& saida;
+    vector<Valor> pilha;
+    vector<Quadro> quadros;
+
+    // Strings criadas na execução
+    static constexpr int64_t MARCA_DINAMICO = (int64_t)0x7E57 << 48; // Nenhum literal chega perto
+    static constexpr size_t LIMIAR_COLETA = 1 << 20;                 // Bytes criados antes da primeira coleta
+    enum EstadoTexto : uint8_t { LIVRE, EM_USO, MARCADO };
+    vector<string> dinamicos;
+    vector<uint8_t> estadoTexto; // EstadoTexto de cada posição de 'dinamicos'
+    vector<uint32_t> livres;     // Posições liberadas, reaproveitadas pelas próximas strings
+    size_t bytesDesdeColeta = 0;
+    size_t limiteColeta;
+
+    const string& texto(int64_t v) const {
+        return v >= MARCA_DINAMICO ? dinamicos[v - MARCA_DINAMICO] : programa.textos[v];
+    }
+
+    // Guarda uma string criada na execução e devolve o Valor dela. Antes, se o que foi criado
+    // desde a última coleta passou do limite, coleta com a pilha viva [inicio, topo).
+    int64_t novoTexto(string&& s, const Valor* inicio, const Valor* topo) {
+        bytesDesdeColeta += s.size() + sizeof(string);
+        if (bytesDesdeColeta > limiteColeta) coletarTextos(inicio, topo);
+        uint32_t k;
+        if (!livres.empty()) {
+            k = livres.back();
+            livres.pop_back();
+            dinamicos[k] = move(s);
+            estadoTexto[k] = EM_USO;
+        } else {
+            k = (uint32_t)dinamicos.size();
+            dinamicos.push_back(move(s));
+            estadoTexto.push_back(EM_USO);
+        }
+        return MARCA_DINAMICO + k;
+    }
+
+    // Coleta conservadora: a pilha viva é a única raiz (globais, quadros e operandos ficam nela).
+    // As posições não dizem o próprio tipo, então todo Valor com o padrão de uma string em uso a
+    // mantém viva; um número que coincida só atrasa a liberação, nunca libera uma string usada.
+    // O limite da próxima coleta acompanha os bytes vivos e o tamanho da pilha, então a memória
+    // fica proporcional às strings vivas e varrer a pilha custa O(1) por byte criado.
+    void coletarTextos(const Valor* inicio, const Valor* topo) {
+        for (const Valor* v = inicio; v < topo; ++v) {
+            uint64_t k = (uint64_t)v->i - (uint64_t)MARCA_DINAMICO;
+            if (k < estadoTexto.size() && estadoTexto[k] == EM_USO) estadoTexto[k] = MARCADO;
+        }
+        size_t vivos = 0;
+        for (size_t k = 0; k < dinamicos.size(); ++k) {
+            if (estadoTexto[k] == MARCADO) {
+                estadoTexto[k] = EM_USO;
+                vivos += dinamicos[k].size() + sizeof(string);
+            } else if (estadoTexto[k] == EM_USO) {
+                string().swap(dinamicos[k]); // Devolve a memória, não só o tamanho
+                estadoTexto[k] = LIVRE;
+                livres.push_back((uint32_t)k);
+            }
+        }
+        bytesDesdeColeta = 0;
+        limiteColeta = max(LIMIAR_COLETA, vivos + (size_t)(topo - inicio) * sizeof(Valor));
+    }
+
+    // Quadro 'saltos' ligações estáticas acima do quadro 'atual'.
+    Valor* quadroExterno(int32_t atual, int32_t saltos) const {
+        for (; saltos > 0; --saltos) atual = quadros[atual].ligacao;
+        return quadros[atual].base;
+    }
+};
+
+#endif
@@ -0,0 +1,734 @@
+#ifndef SEMANTICO_H
+#define SEMANTICO_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+
+#include "../Sintatico/Sintatico.h"
+
+using namespace std;
+
+//================================================================================
+// <<< NOVO: NÚCLEO DA ANÁLISE SEMÂNTICA >>>
+//================================================================================
+
+// O enum TipoDado fica em AST.h: cada nó de expressão guarda o tipo calculado.
+
+// O que um nome declarado é
+enum class Categoria : uint8_t {
+    VARIAVEL,
+    PARAMETRO,
+    CONSTANTE,
+    FUNCAO,
+    PROCEDIMENTO,
+    TIPO,
+    PROGRAMA
+};
+
+// Descrição de um array: tipo dos elementos e limites (array [inicio..fim] of elemento).
+// Dois arrays só são compatíveis se as três partes forem iguais.
+struct TipoArray {
+    TipoDado elemento = TipoDado::INDEFINIDO;
+    int64_t inicio = 0;
+    int64_t fim = 0;
+};
+
+inline bool operator==(const TipoArray& a, const TipoArray& b) {
+    return a.elemento == b.elemento && a.inicio == b.inicio && a.fim == b.fim;
+}
+
+// Parâmetro na assinatura de uma função ou procedimento
+struct Parametro {
+    TipoDado tipo;      // INDEFINIDO aceita argumentos de qualquer tipo (read/write)
+    TipoArray array;    // Quando 'tipo' é ARRAY
+    bool porReferencia; // Parâmetro 'var': o argumento precisa ser uma variável
+};
+
+// Estrutura para uma entrada na tabela de símbolos
+struct Simbolo {
+    Nome nome;          // Nome internado (ver TabelaDeNomes)
+    Categoria categoria;
+    TipoDado tipoDado;  // Tipo da variável/constante, o tipo que um TIPO define, ou FUNCAO/PROCEDIMENTO/PROGRAMA
+    int linhaDeclaracao;
+    TipoArray array = {}; // Quando tipoDado é ARRAY
+
+    // Assinatura (funções e procedimentos)
+    TipoDado tipoRetorno = TipoDado::INDEFINIDO;
+    vector<Parametro> parametros = {};
+    bool variadica = false; // read/write: qualquer número de argumentos, todos conferidos com parametros[0]
+
+    // Variáveis e parâmetros podem receber valores e ser passados para parâmetros 'var'
+    bool ehVariavel() const {
+        return categoria == Categoria::VARIAVEL || categoria == Categoria::PARAMETRO;
+    }
+};
+
+// Classe para gerenciar a Tabela de Símbolos com escopos.
+//
+// Cada nome internado aponta para a declaração visível mais interna; essa declaração
+// guarda a que ela esconde (cadeia de sombreamento). As declarações ficam em ordem em
+// 'entradas', que funciona como log de desfazer: sair de um escopo só desempilha o
+// que ele declarou. Busca e declaração custam O(1), sem copiar nada.
+class TabelaDeSimbolos {
+private:
+    struct Entrada {
+        Simbolo simbolo;
+        int anterior; // Declaração do mesmo nome que esta esconde (-1 = nenhuma)
+        int escopo;   // Profundidade do escopo em que foi declarada
+    };
+
+    const TabelaDeNomes& nomes;
+    vector<Entrada> entradas;    // Declarações ativas, na ordem em que foram feitas
+    vector<int> visivel;         // visivel[nome] = índice em 'entradas' (-1 = não declarado)
+    vector<size_t> inicioEscopo; // Posição em 'entradas' onde cada escopo aberto começa
+    size_t picoSimbolos = 0;     // Maior número de declarações ativas ao mesmo tempo
+    size_t picoProfundidade = 0; // Maior número de escopos abertos ao mesmo tempo
+
+public:
+    explicit TabelaDeSimbolos(const TabelaDeNomes& nomesDaUnidade) : nomes(nomesDaUnidade) {
+        entrarEscopo(); // Inicia com o escopo global para evitar erros de uso de símbolos antes de declarar
+    }
+
+    // Ao entrar em uma função ou bloco, um novo escopo é aberto
+    void entrarEscopo() {
+        inicioEscopo.push_back(entradas.size());
+        picoProfundidade = max(picoProfundidade, inicioEscopo.size());
+    }
+
+    // Ao sair de uma função ou bloco, desfaz apenas as declarações do escopo atual
+    void sairEscopo() {
+        if (inicioEscopo.empty()) return;
+        size_t inicio = inicioEscopo.back();
+        while (entradas.size() > inicio) {
+            const Entrada& e = entradas.back();
+            visivel[e.simbolo.nome] = e.anterior; // Volta a mostrar a declaração escondida
+            entradas.pop_back();
+        }
+        inicioEscopo.pop_back();
+    }
+
+    // Declara um novo símbolo no escopo atual. Devolve false se o nome já existe neste escopo.
+    bool adicionarSimbolo(const Simbolo& s) {
+        if (s.nome >= visivel.size()) visivel.resize(max((size_t)s.nome + 1, nomes.tamanho()), -1);
+        int atual = visivel[s.nome];
+        int escopoAtual = (int)inicioEscopo.size() - 1;
+        if (atual >= 0 && entradas[atual].escopo == escopoAtual) {
+            return false; // Já declarado no mesmo escopo: a declaração existente continua valendo.
+        }
+        entradas.push_back({s, atual, escopoAtual});
+        visivel[s.nome] = (int)entradas.size() - 1;
+        picoSimbolos = max(picoSimbolos, entradas.size());
+        return true;
+    }
+
+    // Busca a declaração visível de um nome (nullptr se não foi declarado).
+    // O ponteiro vale até a próxima declaração.
+    const Simbolo* buscarSimbolo(Nome nome) const {
+        if (nome < visivel.size() && visivel[nome] >= 0) {
+            return &entradas[visivel[nome]].simbolo;
+        }
+        return nullptr;
+    }
+
+    // Profundidade do escopo da declaração visível de um nome (-1 se não foi declarado).
+    int escopoDe(Nome nome) const {
+        if (nome < visivel.size() && visivel[nome] >= 0) return entradas[visivel[nome]].escopo;
+        return -1;
+    }
+
+    size_t quantidadeSimbolos() const { return entradas.size(); }
+    const Simbolo& simbolo(size_t i) const { return entradas[i].simbolo; } // i-ésima declaração ativa
+    size_t profundidade() const { return inicioEscopo.size(); }
+    size_t maiorQuantidadeSimbolos() const { return picoSimbolos; }
+    size_t maiorProfundidade() const { return picoProfundidade; }
+};
+
+// Classe para realizar a análise semântica da AST
+// Os erros não interrompem a análise: cada um é registrado em 'erros' e a visita continua.
+//
+// A checagem de tipos é feita na mesma passada que resolve os nomes: cada nó de expressão é
+// visitado uma vez e recebe o seu tipo em ASTNode::tipoDado, que as fases seguintes reutilizam.
+// Uma expressão com erro fica INDEFINIDO, o que silencia os erros em cascata acima dela.
+class AnalisadorSemantico {
+public:
+    TabelaDeSimbolos tabela;
+    const TabelaDeNomes& tabelaNomes; // Textos dos nomes internados da AST
+    vector<Diagnostico> erros;        // Erros semânticos, na ordem em que foram encontrados
+
+    explicit AnalisadorSemantico(const TabelaDeNomes& nomesDaUnidade)
+        : tabela(nomesDaUnidade), tabelaNomes(nomesDaUnidade) {
+        declararPredefinidos();
+    }
+
+    // Percorre a AST registrando os erros em 'erros', sem imprimir nada. Devolve true se não houve erros.
+    bool verificar(ASTNode* noRaiz) {
+        visitar(noRaiz);
+        return erros.empty();
+    }
+
+    // Método principal que inicia a análise semântica e imprime o resultado. Devolve true se não houve erros.
+    bool analisar(ASTNode* noRaiz) {
+        verificar(noRaiz);
+        if (erros.empty()) {
+            cout << "\nAnalise semantica concluida com sucesso." << endl;
+        } else {
+            cout << "\n";
+            imprimirDiagnosticos(cout, erros);
+        }
+        return erros.empty();
+    }
+
+    // --- Análise por regiões (Compilador/Incremental.h) ---
+    // O programa pode ser conferido uma declaração de nível mais externo por vez. O que cada
+    // região deixa declarado no bloco principal (o seu resumo) é tudo de que as regiões
+    // seguintes dependem, então uma região que não mudou só precisa ter o resumo declarado.
+
+    // Declara o programa e abre o escopo do bloco principal (como visitarPrograma e visitarBloco).
+    void iniciarPrograma(const Simbolo& programa) {
+        declarar(programa);
+        tabela.entrarEscopo();
+    }
+
+    // Confere uma declaração do bloco principal e devolve os símbolos que ela deixou declarados nele.
+    vector<Simbolo> verificarRegiao(ASTNode* no) {
+        size_t marca = tabela.quantidadeSimbolos();
+        visitar(no);
+        vector<Simbolo> resumo;
+        for (size_t i = marca; i < tabela.quantidadeSimbolos(); ++i) resumo.push_back(tabela.simbolo(i));
+        return resumo;
+    }
+
+    // Declara o resumo de uma região que não precisou ser conferida de novo.
+    void declararResumo(const vector<Simbolo>& resumo) {
+        for (const Simbolo& s : resumo) tabela.adicionarSimbolo(s);
+    }
+
+private:
+    // Função cujo corpo está sendo analisado (para conferir o valor de retorno)
+    struct FuncaoAtual {
+        Nome nome;
+        bool retornoDefinido;
+    };
+    vector<FuncaoAtual> funcoes; // Pilha: funções podem ser declaradas dentro de funções
+
+    // Registra um erro semântico
+    void erroSemantico(int linha, const string& mensagem) {
+        erros.push_back({linha, "Erro Semantico na linha " + to_string(linha) + ": " + mensagem});
+    }
+
+    // Declara um símbolo, registrando erro se o nome já existe no escopo atual
+    void declarar(const Simbolo& s) {
+        if (!tabela.adicionarSimbolo(s)) {
+            erroSemantico(s.linhaDeclaracao, "Identificador '" + texto(s.nome) + "' ja foi declarado neste escopo.");
+        }
+    }
+
+    // Busca um identificador usado na linha 'linha'. Se não foi declarado, registra o erro
+    // uma vez e declara o nome como INDEFINIDO no escopo atual, evitando erros em cascata.
+    const Simbolo* usar(Nome nome, int linha) {
+        if (const Simbolo* s = tabela.buscarSimbolo(nome)) return s;
+        erroSemantico(linha, "Identificador '" + texto(nome) + "' nao foi declarado.");
+        tabela.adicionarSimbolo({nome, Categoria::VARIAVEL, TipoDado::INDEFINIDO, linha});
+        return tabela.buscarSimbolo(nome);
+    }
+
+    // read, write, true e false. Só os nomes que aparecem na unidade precisam ser declarados.
+    void declararPredefinidos() {
+        if (Nome n = tabelaNomes.procurar("read")) {
+            Simbolo s = {n, Categoria::PROCEDIMENTO, TipoDado::PROCEDIMENTO, 0};
+            s.parametros = {{TipoDado::INDEFINIDO, {}, true}};
+            s.variadica = true;
+            tabela.adicionarSimbolo(s);
+        }
+        if (Nome n = tabelaNomes.procurar("write")) {
+            Simbolo s = {n, Categoria::PROCEDIMENTO, TipoDado::PROCEDIMENTO, 0};
+            s.parametros = {{TipoDado::INDEFINIDO, {}, false}};
+            s.variadica = true;
+            tabela.adicionarSimbolo(s);
+        }
+        if (Nome n = tabelaNomes.procurar("true")) tabela.adicionarSimbolo({n, Categoria::CONSTANTE, TipoDado::BOOLEANO, 0});
+        if (Nome n = tabelaNomes.procurar("false")) tabela.adicionarSimbolo({n, Categoria::CONSTANTE, TipoDado::BOOLEANO, 0});
+    }
+
+    // Texto de um nome internado da AST
+    const string& texto(Nome n) const {
+        return tabelaNomes.texto(n);
+    }
+
+    // Texto de um tipo entre aspas, para as mensagens
+    static string nomeTipo(TipoDado t) {
+        return string("'") + nomeTipoDado(t) + "'";
+    }
+
+    // Como nomeTipo, mas um array aparece com os limites e o tipo dos elementos
+    static string nomeTipo(TipoDado t, const TipoArray* array) {
+        if (t != TipoDado::ARRAY || !array) return nomeTipo(t);
+        return "'array [" + to_string(array->inicio) + ".." + to_string(array->fim) + "] of "
+               + nomeTipoDado(array->elemento) + "'";
+    }
+
+    // Converte uma string de tipo para nosso enum
+    TipoDado stringParaTipoDado(const string& tipoStr) {
+        if (tipoStr == "integer") return TipoDado::INTEIRO;
+        if (tipoStr == "boolean") return TipoDado::BOOLEANO;
+        if (tipoStr == "real") return TipoDado::REAL;
+        if (tipoStr == "string") return TipoDado::STRING;
+        return TipoDado::INDEFINIDO;
+    }
+
+    static bool numerico(TipoDado t) {
+        return t == TipoDado::INTEIRO || t == TipoDado::REAL;
+    }
+
+    // Um valor do tipo 'origem' pode ser guardado em um destino do tipo 'destino'?
+    // integer é promovido para real; INDEFINIDO (erro já registrado) é aceito.
+    static bool compativel(TipoDado destino, TipoDado origem) {
+        return destino == origem || destino == TipoDado::INDEFINIDO || origem == TipoDado::INDEFINIDO
+            || (destino == TipoDado::REAL && origem == TipoDado::INTEIRO);
+    }
+
+    // Dois arrays são compatíveis se têm o mesmo tipo de elemento e os mesmos limites.
+    // Sem a descrição de um deles, ou com elementos INDEFINIDO (erro já registrado), aceita.
+    static bool arraysCompativeis(const TipoArray* destino, const TipoArray* origem) {
+        if (!destino || !origem || destino->elemento == TipoDado::INDEFINIDO || origem->elemento == TipoDado::INDEFINIDO) {
+            return true;
+        }
+        return *destino == *origem;
+    }
+
+    // Descrição do array de uma expressão já tipada (nullptr se ela não é um array).
+    // Só variáveis e parâmetros podem ter tipo array: funções não retornam arrays.
+    const TipoArray* arrayDe(ASTNode* no) const {
+        if (no->tipoDado != TipoDado::ARRAY || no->tipo != TipoNo::IDENTIFICADOR) return nullptr;
+        const Simbolo* s = tabela.buscarSimbolo(no->valor);
+        return s ? &s->array : nullptr;
+    }
+
+    // Tipo descrito por um nó de tipo (TIPO_PRIMITIVO, TIPO_ARRAY ou TIPO_IDENTIFICADOR).
+    // Para arrays, 'array' recebe o tipo dos elementos e os limites.
+    TipoDado resolverTipo(ASTNode* noTipo, TipoArray& array) {
+        array = {};
+        switch (noTipo->tipo) {
+            case TipoNo::TIPO_PRIMITIVO: {
+                if (!noTipo->valor) return TipoDado::INDEFINIDO; // Tipo ausente (recuperado de erro sintático)
+                TipoDado tipo = stringParaTipoDado(texto(noTipo->valor));
+                if (tipo == TipoDado::INDEFINIDO) {
+                    // ERRO SEMÂNTICO: O tipo usado na declaração não é válido.
+                    erroSemantico(noTipo->linha, "Tipo '" + texto(noTipo->valor) + "' desconhecido.");
+                }
+                return tipo;
+            }
+            case TipoNo::TIPO_ARRAY: {
+                const string& inicio = texto(noTipo->filhos[0]->valor);
+                const string& fim = texto(noTipo->filhos[1]->valor);
+                array.inicio = strtoll(inicio.c_str(), nullptr, 10);
+                array.fim = strtoll(fim.c_str(), nullptr, 10);
+                if (array.inicio > array.fim) {
+                    erroSemantico(noTipo->linha, "Limites do array invalidos: " + inicio + ".." + fim + ".");
+                }
+                TipoArray interno;
+                array.elemento = resolverTipo(noTipo->filhos[2], interno);
+                if (array.elemento == TipoDado::ARRAY) {
+                    erroSemantico(noTipo->linha, "Arrays de arrays nao sao suportados.");
+                    array.elemento = TipoDado::INDEFINIDO;
+                }
+                return TipoDado::ARRAY;
+            }
+            case TipoNo::TIPO_IDENTIFICADOR: {
+                const Simbolo* s = tabela.buscarSimbolo(noTipo->valor);
+                if (!s || s->categoria != Categoria::TIPO) {
+                    erroSemantico(noTipo->linha, "Tipo '" + texto(noTipo->valor) + "' desconhecido.");
+                    return TipoDado::INDEFINIDO;
+                }
+                array = s->array;
+                return s->tipoDado;
+            }
+            default:
+                return TipoDado::INDEFINIDO;
+        }
+    }
+
+    // Método "dispatcher": decide qual função de visita chamar com base no tipo do nó
+    void visitar(ASTNode* no) {
+        if (!no) return;
+
+        switch (no->tipo) {
+            case TipoNo::PROGRAMA: visitarPrograma(no); break;
+            case TipoNo::BLOCO: visitarBloco(no); break;
+            case TipoNo::DECLARACAO_TIPOS: visitarDeclaracaoTipos(no); break;
+            case TipoNo::DECLARACAO_VARIAVEIS: visitarDeclaracaoVariaveis(no); break;
+            case TipoNo::FUNCAO:
+            case TipoNo::PROCEDIMENTO: visitarDeclaracaoFuncao(no); break;
+            case TipoNo::ATRIBUICAO:
+            case TipoNo::RETORNO_FUNCAO: visitarAtribuicao(no); break;
+            case TipoNo::IF: visitarCondicional(no, "if"); break;
+            case TipoNo::WHILE: visitarCondicional(no, "while"); break;
+            case TipoNo::FOR: visitarFor(no); break;
+            case TipoNo::CHAMADA_SUBROTINA: visitarChamada(no, false); break;
+            case TipoNo::IDENTIFICADOR:
+            case TipoNo::ACESSO_ARRAY:
+            case TipoNo::OPERADOR_BINARIO:
+            case TipoNo::OPERADOR_UNARIO:
+            case TipoNo::NUMERO:
+            case TipoNo::STRING: tipoExpressao(no); break;
+            default:
+                // Se o nó não precisa de uma ação especial, apenas visita seus filhos recursivamente
+                for (ASTNode* filho : no->filhos) {
+                    visitar(filho);
+                }
+        }
+    }
+
+    // Visita o nó do programa
+    void visitarPrograma(ASTNode* no) {
+        Simbolo s = {no->valor, Categoria::PROGRAMA, TipoDado::PROGRAMA, no->linha};
+        declarar(s);
+        visitar(no->filhos[0]); // Visita o bloco principal
+    }
+
+    // Visita um bloco, criando e destruindo um novo escopo
+    void visitarBloco(ASTNode* no) {
+        tabela.entrarEscopo();
+        for (ASTNode* filho : no->filhos) {
+            visitar(filho);
+        }
+        tabela.sairEscopo();
+    }
+
+    // Visita uma declaração de função ou procedimento
+    void visitarDeclaracaoFuncao(ASTNode* no) {
+        bool ehFuncao = no->tipo == TipoNo::FUNCAO;
+
+        // 1. Monta a assinatura e adiciona o nome ao escopo atual ANTES de processar o corpo,
+        //    para que chamadas recursivas sejam conferidas contra ela
+        Simbolo s = ehFuncao ? Simbolo{no->valor, Categoria::FUNCAO, TipoDado::FUNCAO, no->linha}
+                             : Simbolo{no->valor, Categoria::PROCEDIMENTO, TipoDado::PROCEDIMENTO, no->linha};
+        ASTNode* noParams = no->filhos[0];
+        if (noParams->tipo == TipoNo::LISTA_PARAMETROS) {
+            for (ASTNode* grupo : noParams->filhos) { // Para cada grupo (ex: a, b: integer)
+                Parametro p;
+                p.tipo = resolverTipo(grupo->filhos[1], p.array);
+                p.porReferencia = grupo->tipo == TipoNo::GRUPO_PARAMETRO_REF;
+                s.parametros.insert(s.parametros.end(), grupo->filhos[0]->filhos.size(), p);
+            }
+        }
+        if (ehFuncao) {
+            TipoArray array;
+            s.tipoRetorno = resolverTipo(no->filhos[1], array);
+            if (s.tipoRetorno == TipoDado::ARRAY) {
+                erroSemantico(no->linha, "Funcao '" + texto(no->valor) + "' nao pode retornar um array.");
+                s.tipoRetorno = TipoDado::INDEFINIDO;
+            }
+        }
+        if (no->valor) declarar(s); // Sub-rotina sem nome (recuperada de erro sintático) não é declarada
+
+        // 2. Cria um novo escopo para os parâmetros e variáveis locais da função. É um escopo só:
+        //    uma variável local com o nome de um parâmetro é uma redeclaração.
+        tabela.entrarEscopo();
+
+        // 3. Declara os parâmetros com os tipos já resolvidos na assinatura
+        size_t k = 0;
+        if (noParams->tipo == TipoNo::LISTA_PARAMETROS) {
+            for (ASTNode* grupo : noParams->filhos) {
+                for (ASTNode* id : grupo->filhos[0]->filhos) {
+                    const Parametro& p = s.parametros[k++];
+                    declarar({id->valor, Categoria::PARAMETRO, p.tipo, id->linha, p.array});
+                }
+            }
+        }
+
+        // 4. Processa o bloco da função no escopo dos parâmetros (sem o escopo próprio de
+        //    visitarBloco), conferindo se ela define o seu valor de retorno
+        if (ehFuncao) funcoes.push_back({no->valor, false});
+        ASTNode* corpo = no->filhos[no->filhos.size() - 1];
+        if (corpo->tipo == TipoNo::BLOCO) {
+            for (ASTNode* filho : corpo->filhos) visitar(filho);
+        } else {
+            visitar(corpo);
+        }
+        if (ehFuncao) {
+            if (!funcoes.back().retornoDefinido && no->valor) {
+                erroSemantico(no->linha, "Funcao '" + texto(no->valor) + "' nao define o seu valor de retorno.");
+            }
+            funcoes.pop_back();
+        }
+
+        // 5. Sai do escopo da função
+        tabela.sairEscopo();
+    }
+
+    // Visita uma declaração de tipos (ex: type Vetor = array [1..10] of integer;)
+    void visitarDeclaracaoTipos(ASTNode* no) {
+        for (ASTNode* decl : no->filhos) {
+            TipoArray array;
+            TipoDado tipo = resolverTipo(decl->filhos[0], array);
+            declarar({decl->valor, Categoria::TIPO, tipo, decl->linha, array});
+        }
+    }
+
+    // Visita uma declaração de variáveis
+    void visitarDeclaracaoVariaveis(ASTNode* no) {
+        for (ASTNode* decl : no->filhos) { // Para cada 'grupo' de declaração (ex: a,b:integer;)
+            ASTNode* listaIds = decl->filhos[0];
+            ASTNode* noTipo = decl->filhos[1];
+
+            // Com tipo desconhecido as variáveis são declaradas mesmo assim (INDEFINIDO),
+            // para que seus usos não gerem mais erros.
+            TipoArray array;
+            TipoDado tipo = resolverTipo(noTipo, array);
+
+            // Para cada identificador na lista 
+            for (ASTNode* id : listaIds->filhos) {
+                Simbolo s = {id->valor, Categoria::VARIAVEL, tipo, id->linha, array};
+                declarar(s); // Ação Semântica: Adiciona à tabela
+            }
+        }
+    }
+
+    // Visita um nó de atribuição (ou de valor de retorno de função)
+    void visitarAtribuicao(ASTNode* no) {
+        // O filho da esquerda é a variável que recebe o valor
+        ASTNode* variavelNode = no->filhos[0];
+        // O filho da direita é a expressão
+        ASTNode* expressaoNode = no->filhos[1];
+
+        TipoDado destino = tipoDestino(variavelNode);
+        TipoDado origem = tipoExpressao(expressaoNode);
+
+        // <<<CHECAGEM DE TIPOS >>>
+        const TipoArray* arrayDestino = arrayDe(variavelNode);
+        const TipoArray* arrayOrigem = arrayDe(expressaoNode);
+        if (!compativel(destino, origem) || !arraysCompativeis(arrayDestino, arrayOrigem)) {
+            erroSemantico(no->linha, "Tipos incompativeis na atribuicao a '" + texto(variavelNode->valor) + "': esperado "
+                          + nomeTipo(destino, arrayDestino) + ", encontrado " + nomeTipo(origem, arrayOrigem) + ".");
+        }
+        no->tipoDado = destino;
+    }
+
+    // Tipo do lado esquerdo de uma atribuição. Atribuir ao nome da função (dentro dela)
+    // define o valor de retorno.
+    TipoDado tipoDestino(ASTNode* variavelNode) {
+        if (variavelNode->tipo == TipoNo::ACESSO_ARRAY) return tipoExpressao(variavelNode);
+
+        // Ação Semântica: Verifica se a variável do lado esquerdo foi declarada.
+        const Simbolo* s = usar(variavelNode->valor, variavelNode->linha);
+        TipoDado destino = TipoDado::INDEFINIDO;
+        if (s->ehVariavel()) {
+            destino = s->tipoDado;
+        } else if (s->categoria == Categoria::FUNCAO) {
+            auto f = find_if(funcoes.rbegin(), funcoes.rend(), [&](const FuncaoAtual& fa) { return fa.nome == s->nome; });
+            if (f == funcoes.rend()) {
+                erroSemantico(variavelNode->linha, "Valor de retorno da funcao '" + texto(s->nome) + "' so pode ser definido dentro dela.");
+            } else {
+                f->retornoDefinido = true;
+                destino = s->tipoRetorno;
+            }
+        } else {
+            erroSemantico(variavelNode->linha, "'" + texto(s->nome) + "' nao pode receber um valor.");
+        }
+        variavelNode->tipoDado = destino;
+        return destino;
+    }
+
+    // Visita um 'if' ou 'while': a condição deve ser boolean
+    void visitarCondicional(ASTNode* no, const char* comando) {
+        ASTNode* cond = no->filhos[0];
+        TipoDado tipo = tipoExpressao(cond);
+        if (tipo != TipoDado::BOOLEANO && tipo != TipoDado::INDEFINIDO) {
+            erroSemantico(cond->linha, string("Condicao do '") + comando + "' deve ser boolean, encontrado " + nomeTipo(tipo) + ".");
+        }
+        for (size_t i = 1; i < no->filhos.size(); ++i) {
+            visitar(no->filhos[i]);
+        }
+    }
+
+    // Visita um 'for': a variável de controle e os dois limites devem ser integer
+    void visitarFor(ASTNode* no) {
+        ASTNode* variavelNode = no->filhos[0];
+        const Simbolo* s = usar(variavelNode->valor, variavelNode->linha);
+        if (!s->ehVariavel()) {
+            erroSemantico(variavelNode->linha, "'" + texto(s->nome) + "' nao pode ser a variavel de controle do 'for'.");
+        } else if (s->tipoDado != TipoDado::INTEIRO && s->tipoDado != TipoDado::INDEFINIDO) {
+            erroSemantico(variavelNode->linha, "Variavel de controle do 'for' deve ser integer, encontrado " + nomeTipo(s->tipoDado) + ".");
+        }
+        variavelNode->tipoDado = s->tipoDado;
+        for (size_t i = 1; i <= 2; ++i) {
+            TipoDado limite = tipoExpressao(no->filhos[i]);
+            if (limite != TipoDado::INTEIRO && limite != TipoDado::INDEFINIDO) {
+                erroSemantico(no->filhos[i]->linha, "Limite do 'for' deve ser integer, encontrado " + nomeTipo(limite) + ".");
+            }
+        }
+        visitar(no->filhos[3]);
+    }
+
+    // Visita uma chamada de função ou procedimento, conferindo quantidade e tipos dos argumentos.
+    // Em uma expressão, devolve o tipo de retorno.
+    TipoDado visitarChamada(ASTNode* no, bool emExpressao) {
+        // Os argumentos são tipados primeiro: depois, basta ler o tipo guardado em cada nó
+        ASTNode* args = no->filhos.empty() ? nullptr : no->filhos[0];
+        size_t quantidade = args ? args->filhos.size() : 0;
+        for (size_t i = 0; i < quantidade; ++i) {
+            tipoExpressao(args->filhos[i]);
+        }
+
+        const Simbolo* s = usar(no->valor, no->linha);
+        const string& nome = texto(no->valor);
+        bool ehFuncao = s->categoria == Categoria::FUNCAO;
+        if (!ehFuncao && s->categoria != Categoria::PROCEDIMENTO) {
+            if (s->tipoDado != TipoDado::INDEFINIDO) {
+                erroSemantico(no->linha, "'" + nome + "' nao e uma funcao nem um procedimento.");
+            }
+            return TipoDado::INDEFINIDO;
+        }
+        if (emExpressao && !ehFuncao) {
+            erroSemantico(no->linha, "Procedimento '" + nome + "' nao retorna valor e nao pode ser usado em uma expressao.");
+        }
+
+        if (!s->variadica && quantidade != s->parametros.size()) {
+            erroSemantico(no->linha, "'" + nome + "' espera " + to_string(s->parametros.size()) + " argumento(s), mas recebeu "
+                          + to_string(quantidade) + ".");
+        } else {
+            for (size_t i = 0; i < quantidade; ++i) {
+                ASTNode* arg = args->filhos[i];
+                if (s->variadica && arg->tipoDado == TipoDado::ARRAY) {
+                    erroSemantico(arg->linha, "Argumento " + to_string(i + 1) + " de '" + nome + "' nao pode ser um array.");
+                    continue;
+                }
+                conferirArgumento(arg, s->variadica ? s->parametros[0] : s->parametros[i], i + 1, nome);
+            }
+        }
+        return emExpressao && ehFuncao ? s->tipoRetorno : TipoDado::INDEFINIDO;
+    }
+
+    // Confere um argumento (já tipado) contra o parâmetro correspondente
+    void conferirArgumento(ASTNode* arg, const Parametro& p, size_t indice, const string& nome) {
+        string qual = "Argumento " + to_string(indice) + " de '" + nome + "'";
+        const TipoArray* arrayParametro = p.tipo == TipoDado::ARRAY ? &p.array : nullptr;
+        const TipoArray* arrayArgumento = arrayDe(arg);
+        auto tipos = [&]() {
+            return ": esperado " + nomeTipo(p.tipo, arrayParametro) + ", encontrado " + nomeTipo(arg->tipoDado, arrayArgumento) + ".";
+        };
+        if (p.porReferencia) {
+            bool ehVariavel = arg->tipo == TipoNo::ACESSO_ARRAY;
+            if (arg->tipo == TipoNo::IDENTIFICADOR) {
+                const Simbolo* v = tabela.buscarSimbolo(arg->valor);
+                ehVariavel = v && v->ehVariavel();
+            }
+            if (!ehVariavel) {
+                erroSemantico(arg->linha, qual + " deve ser uma variavel.");
+            } else if (p.tipo != TipoDado::INDEFINIDO && arg->tipoDado != TipoDado::INDEFINIDO
+                       && (arg->tipoDado != p.tipo || !arraysCompativeis(arrayParametro, arrayArgumento))) {
+                erroSemantico(arg->linha, qual + tipos());
+            }
+        } else if (!compativel(p.tipo, arg->tipoDado) || !arraysCompativeis(arrayParametro, arrayArgumento)) {
+            erroSemantico(arg->linha, qual + tipos());
+        }
+    }
+
+    // Calcula o tipo de uma expressão e o guarda em no->tipoDado. Cada nó é visitado uma única vez.
+    TipoDado tipoExpressao(ASTNode* no) {
+        TipoDado tipo = TipoDado::INDEFINIDO;
+        switch (no->tipo) {
+            case TipoNo::NUMERO:
+                tipo = texto(no->valor).find('.') == string::npos ? TipoDado::INTEIRO : TipoDado::REAL;
+                break;
+            case TipoNo::STRING: tipo = TipoDado::STRING; break;
+            case TipoNo::IDENTIFICADOR: tipo = tipoIdentificador(no); break;
+            case TipoNo::ACESSO_ARRAY: tipo = tipoAcessoArray(no); break;
+            case TipoNo::CHAMADA_SUBROTINA: tipo = visitarChamada(no, true); break;
+            case TipoNo::OPERADOR_UNARIO: tipo = tipoOperadorUnario(no); break;
+            case TipoNo::OPERADOR_BINARIO: tipo = tipoOperadorBinario(no); break;
+            default: break;
+        }
+        no->tipoDado = tipo;
+        return tipo;
+    }
+
+    // Visita um nó de identificador usado em uma expressão
+    TipoDado tipoIdentificador(ASTNode* no) {
+        // Ação Semântica: Verifica se o identificador foi declarado.
+        const Simbolo* s = usar(no->valor, no->linha);
+        if (s->categoria == Categoria::FUNCAO) { // Chamada sem parênteses (ex: x := f)
+            if (!s->parametros.empty()) {
+                erroSemantico(no->linha, "'" + texto(no->valor) + "' espera " + to_string(s->parametros.size())
+                              + " argumento(s), mas recebeu 0.");
+            }
+            return s->tipoRetorno;
+        }
+        if (s->categoria == Categoria::PROCEDIMENTO || s->categoria == Categoria::PROGRAMA || s->categoria == Categoria::TIPO) {
+            erroSemantico(no->linha, "'" + texto(no->valor) + "' nao pode ser usado em uma expressao.");
+            return TipoDado::INDEFINIDO;
+        }
+        return s->tipoDado;
+    }
+
+    // Acesso a um elemento de array: o índice deve ser integer
+    TipoDado tipoAcessoArray(ASTNode* no) {
+        const Simbolo* s = usar(no->valor, no->linha);
+        TipoDado tipoVariavel = s->tipoDado;
+        TipoDado elemento = s->array.elemento;
+        bool ehVariavel = s->ehVariavel();
+        no->filhos[0]->tipoDado = tipoVariavel;
+        if (tipoVariavel != TipoDado::INDEFINIDO && (!ehVariavel || tipoVariavel != TipoDado::ARRAY)) {
+            erroSemantico(no->linha, "'" + texto(no->valor) + "' nao e um array.");
+        }
+
+        TipoDado indice = tipoExpressao(no->filhos[1]);
+        if (indice != TipoDado::INTEIRO && indice != TipoDado::INDEFINIDO) {
+            erroSemantico(no->linha, "Indice do array '" + texto(no->valor) + "' deve ser integer, encontrado " + nomeTipo(indice) + ".");
+        }
+        return ehVariavel && tipoVariavel == TipoDado::ARRAY ? elemento : TipoDado::INDEFINIDO;
+    }
+
+    TipoDado tipoOperadorUnario(ASTNode* no) {
+        TipoDado operando = tipoExpressao(no->filhos[0]);
+        if (operando == TipoDado::INDEFINIDO) return TipoDado::INDEFINIDO; // Erro já registrado
+        Operador op = operadorDoNome(no->valor);
+        if (op == Operador::NOT ? (operando == TipoDado::BOOLEANO || operando == TipoDado::INTEIRO) : numerico(operando)) {
+            return operando;
+        }
+        erroSemantico(no->linha, "Operador '" + texto(no->valor) + "' nao pode ser aplicado a " + nomeTipo(operando) + ".");
+        return TipoDado::INDEFINIDO;
+    }
+
+    TipoDado tipoOperadorBinario(ASTNode* no) {
+        TipoDado esq = tipoExpressao(no->filhos[0]);
+        TipoDado dir = tipoExpressao(no->filhos[1]);
+        if (esq == TipoDado::INDEFINIDO || dir == TipoDado::INDEFINIDO) return TipoDado::INDEFINIDO; // Erro já registrado
+
+        switch (operadorDoNome(no->valor)) {
+            case Operador::SOMA:
+                if (esq == TipoDado::STRING && dir == TipoDado::STRING) return TipoDado::STRING; // Concatenação
+                [[fallthrough]];
+            case Operador::SUBTRACAO:
+            case Operador::MULTIPLICACAO:
+                if (numerico(esq) && numerico(dir)) {
+                    return esq == TipoDado::REAL || dir == TipoDado::REAL ? TipoDado::REAL : TipoDado::INTEIRO;
+                }
+                break;
+            case Operador::DIVISAO:
+                if (numerico(esq) && numerico(dir)) return TipoDado::REAL;
+                break;
+            case Operador::DIV:
+            case Operador::MOD:
+                if (esq == TipoDado::INTEIRO && dir == TipoDado::INTEIRO) return TipoDado::INTEIRO;
+                break;
+            case Operador::AND:
+            case Operador::OR:
+                if (esq == TipoDado::BOOLEANO && dir == TipoDado::BOOLEANO) return TipoDado::BOOLEANO;
+                break;
+            default: // Relacionais: = <> < <= > >=
+                if ((numerico(esq) && numerico(dir)) || (esq == dir && (esq == TipoDado::BOOLEANO || esq == TipoDado::STRING))) {
+                    return TipoDado::BOOLEANO;
+                }
+        }
+        erroSemantico(no->linha, "Operador '" + texto(no->valor) + "' nao pode ser aplicado a " + nomeTipo(esq) + " e " + nomeTipo(dir) + ".");
+        return TipoDado::INDEFINIDO;
+    }
+};
+
+#endif
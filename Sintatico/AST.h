@@ -0,0 +1,271 @@
+#ifndef AST_H
+#define AST_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+//================================================================================
+// NOMES INTERNADOS
+//================================================================================
+
+// Identificador de um texto internado: textos iguais recebem o mesmo número.
+// O nome 0 é sempre o texto vazio.
+typedef uint32_t Nome;
+
+// Operadores das expressões. Toda TabelaDeNomes interna os textos dos operadores primeiro, na
+// ordem do enum, então o nome de um operador é o próprio código dele: as fases seguintes
+// comparam enums em vez de textos.
+enum class Operador : uint8_t {
+    NENHUM, // Nome 0 (texto vazio): o nome não é um operador
+    SOMA, SUBTRACAO, MULTIPLICACAO, DIVISAO, DIV, MOD,
+    AND, OR, NOT,
+    IGUAL, DIFERENTE, MENOR, MENOR_IGUAL, MAIOR, MAIOR_IGUAL,
+    NUM_OPERADORES
+};
+
+inline const char* const TEXTOS_OPERADORES[] = {
+    "", "+", "-", "*", "/", "div", "mod", "and", "or", "not", "=", "<>", "<", "<=", ">", ">="
+};
+static_assert(sizeof(TEXTOS_OPERADORES) / sizeof(TEXTOS_OPERADORES[0]) == (size_t)Operador::NUM_OPERADORES,
+              "um texto para cada operador");
+
+// Operador de um nome internado (NENHUM se o nome não é um operador).
+inline Operador operadorDoNome(Nome n) {
+    return n < (Nome)Operador::NUM_OPERADORES ? (Operador)n : Operador::NENHUM;
+}
+
+// Guarda uma única cópia de cada identificador, número ou operador da AST.
+class TabelaDeNomes {
+private:
+    deque<string> textos; // deque: os endereços dos textos não mudam ao crescer
+    unordered_map<string_view, Nome> indice;
+
+public:
+    TabelaDeNomes() {
+        internarOperadores();
+    }
+
+    // Devolve o nome do texto, criando-o na primeira vez.
+    Nome internar(string_view texto) {
+        auto it = indice.find(texto);
+        if (it != indice.end()) return it->second;
+        textos.emplace_back(texto);
+        Nome n = (Nome)(textos.size() - 1);
+        indice.emplace(textos.back(), n);
+        return n;
+    }
+
+    const string& texto(Nome n) const { return textos[n]; }
+
+    // Procura um texto sem internar (0 se ainda não existe).
+    Nome procurar(string_view texto) const {
+        auto it = indice.find(texto);
+        return it == indice.end() ? 0 : it->second;
+    }
+    size_t tamanho() const { return textos.size(); }
+
+    void limpar() {
+        indice.clear();
+        textos.clear();
+        internarOperadores();
+    }
+
+private:
+    // O texto vazio (nome 0) e os operadores, com nomes iguais aos códigos de Operador.
+    void internarOperadores() {
+        for (const char* texto : TEXTOS_OPERADORES) internar(texto);
+    }
+};
+
+//================================================================================
+// ARENA
+//================================================================================
+
+// Alocador por incremento de ponteiro: cada nó custa alguns bytes de um bloco grande
+// e a árvore inteira é liberada de uma vez, sem percorrer os nós.
+class ArenaAST {
+private:
+    static constexpr size_t TAM_BLOCO_INICIAL = 64 * 1024;
+    static constexpr size_t TAM_BLOCO_MAXIMO = 1024 * 1024; // Limita o espaço ocioso do último bloco
+
+    vector<unique_ptr<char[]>> blocos;
+    vector<size_t> tamanhos;
+    size_t blocoAtual = 0;
+    char* livre = nullptr;
+    size_t restante = 0;
+    size_t usados = 0; // Bytes entregues desde o último limpar()
+
+    void novoBloco(size_t minimo) {
+        // Reaproveita blocos já alocados antes de pedir memória nova.
+        while (blocoAtual + 1 < blocos.size()) {
+            ++blocoAtual;
+            if (tamanhos[blocoAtual] >= minimo) {
+                livre = blocos[blocoAtual].get();
+                restante = tamanhos[blocoAtual];
+                return;
+            }
+        }
+        size_t tamanho = blocos.empty() ? TAM_BLOCO_INICIAL : min(tamanhos.back() * 2, TAM_BLOCO_MAXIMO);
+        while (tamanho < minimo) tamanho *= 2;
+        blocos.emplace_back(new char[tamanho]);
+        tamanhos.push_back(tamanho);
+        blocoAtual = blocos.size() - 1;
+        livre = blocos.back().get();
+        restante = tamanho;
+    }
+
+public:
+    ArenaAST() = default;
+    ArenaAST(const ArenaAST&) = delete;
+    ArenaAST& operator=(const ArenaAST&) = delete;
+
+    void* alocar(size_t bytes, size_t alinhamento = alignof(max_align_t)) {
+        size_t ajuste = (alinhamento - ((uintptr_t)livre & (alinhamento - 1))) & (alinhamento - 1);
+        if (!livre || ajuste + bytes > restante) {
+            novoBloco(bytes + alinhamento);
+            ajuste = (alinhamento - ((uintptr_t)livre & (alinhamento - 1))) & (alinhamento - 1);
+        }
+        char* p = livre + ajuste;
+        livre = p + bytes;
+        restante -= ajuste + bytes;
+        usados += bytes;
+        return p;
+    }
+
+    // Descarta todos os nós de uma vez; os blocos ficam para a próxima unidade.
+    void limpar() {
+        blocoAtual = 0;
+        livre = blocos.empty() ? nullptr : blocos[0].get();
+        restante = blocos.empty() ? 0 : tamanhos[0];
+        usados = 0;
+    }
+
+    size_t bytesUsados() const { return usados; }
+    size_t bytesReservados() const {
+        size_t total = 0;
+        for (size_t t : tamanhos) total += t;
+        return total;
+    }
+};
+
+//================================================================================
+// NÓS DA AST
+//================================================================================
+
+// Tipos de nó da Árvore Sintática Abstrata.
+enum class TipoNo : uint8_t {
+    PROGRAMA, BLOCO,
+    DECLARACAO_ROTULOS, ROTULO, DECLARACAO_TIPOS, DECLARACAO_TIPO,
+    DECLARACAO_VARIAVEIS, DECLARACAO_VARIAVEL, LISTA_IDENTIFICADORES, IDENTIFICADOR,
+    TIPO_PRIMITIVO, TIPO_ARRAY, TIPO_IDENTIFICADOR,
+    FUNCAO, PROCEDIMENTO, PARAMETROS_VAZIOS, LISTA_PARAMETROS,
+    GRUPO_PARAMETRO_REF, GRUPO_PARAMETRO_VALOR,
+    LISTA_COMANDOS, ROTULO_USO, COMANDO_COM_ROTULO,
+    IF, WHILE, FOR, GOTO, ATRIBUICAO, RETORNO_FUNCAO, CHAMADA_SUBROTINA, LISTA_ARGUMENTOS,
+    ACESSO_ARRAY, OPERADOR_BINARIO, OPERADOR_UNARIO, NUMERO, STRING,
+    NUM_TIPOS_NO
+};
+
+// Tipos de dado da linguagem. A análise semântica anota o tipo de cada expressão no nó.
+enum class TipoDado : uint8_t {
+    INDEFINIDO, // Ainda não calculado, ou expressão com erro (não gera erros em cascata)
+    INTEIRO,
+    BOOLEANO,
+    REAL,
+    STRING,
+    PROGRAMA,
+    FUNCAO,
+    PROCEDIMENTO,
+    TIPO_DEFINIDO, // Para quando se cria um novo tipo (ex: type MeuArray = ...)
+    ARRAY
+};
+
+// Nome de cada tipo de dado, como escrito no código fonte.
+inline const char* nomeTipoDado(TipoDado t) {
+    static const char* const nomes[] = {
+        "indefinido", "integer", "boolean", "real", "string", "programa", "funcao", "procedimento", "tipo", "array"
+    };
+    return nomes[(size_t)t];
+}
+
+// Nome de cada tipo de nó, usado ao imprimir a árvore.
+inline const char* nomeTipoNo(TipoNo t) {
+    static const char* const nomes[] = {
+        "programa", "bloco",
+        "declaracao_rotulos", "rotulo", "declaracao_tipos", "declaracao_tipo",
+        "declaracao_variaveis", "declaracao_variavel", "lista_identificadores", "identificador",
+        "tipo_primitivo", "tipo_array", "tipo_identificador",
+        "funcao", "procedimento", "parametros_vazios", "lista_parametros",
+        "grupo_parametro_ref", "grupo_parametro_valor",
+        "lista_comandos", "rotulo_uso", "comando_com_rotulo",
+        "if", "while", "for", "goto", "atribuicao", "retorno_funcao", "chamada_subrotina", "lista_argumentos",
+        "acesso_array", "operador_binario", "operador_unario", "numero", "string"
+    };
+    static_assert(sizeof(nomes) / sizeof(nomes[0]) == (size_t)TipoNo::NUM_TIPOS_NO, "nomeTipoNo desatualizado");
+    return nomes[(size_t)t];
+}
+
+struct ASTNode;
+
+// Filhos de um nó em um vetor contíguo dentro da arena.
+// Ao crescer, o vetor é copiado para um espaço maior (o antigo fica na arena até limpar()).
+struct ListaFilhos {
+    ASTNode** dados = nullptr;
+    uint32_t quantidade = 0;
+    uint32_t capacidade = 0;
+
+    void adicionar(ASTNode* filho, ArenaAST& arena) {
+        if (quantidade == capacidade) {
+            uint32_t novaCapacidade = capacidade ? capacidade * 2 : 2;
+            ASTNode** novos = (ASTNode**)arena.alocar(novaCapacidade * sizeof(ASTNode*), alignof(ASTNode*));
+            if (quantidade) memcpy(novos, dados, quantidade * sizeof(ASTNode*));
+            dados = novos;
+            capacidade = novaCapacidade;
+        }
+        dados[quantidade++] = filho;
+    }
+
+    // Reserva espaço para 'n' filhos quando a quantidade já é conhecida (evita as cópias ao crescer).
+    void reservar(uint32_t n, ArenaAST& arena) {
+        if (n <= capacidade) return;
+        ASTNode** novos = (ASTNode**)arena.alocar(n * sizeof(ASTNode*), alignof(ASTNode*));
+        if (quantidade) memcpy(novos, dados, quantidade * sizeof(ASTNode*));
+        dados = novos;
+        capacidade = n;
+    }
+
+    size_t size() const { return quantidade; }
+    bool empty() const { return quantidade == 0; }
+    ASTNode* operator[](size_t i) const { return dados[i]; }
+    ASTNode* const* begin() const { return dados; }
+    ASTNode* const* end() const { return dados + quantidade; }
+};
+
+// Define a estrutura para um nó da Árvore Sintática Abstrata (AST).
+// Os nós vivem na arena e não têm destrutor: a árvore some com ArenaAST::limpar().
+struct ASTNode {
+    TipoNo tipo;
+    TipoDado tipoDado;  // Tipo calculado pela análise semântica (expressões e destinos de atribuição).
+    int linha;          // Linha do código fonte que originou o nó.
+    Nome valor;         // Identificador, número ou operador (0 = sem valor).
+    ListaFilhos filhos;
+};
+static_assert(sizeof(ASTNode) <= 32, "ASTNode deve continuar em 32 bytes");
+
+// Cria um nó na arena (placement new: o objeto passa a existir na memória crua da arena).
+inline ASTNode* criarNo(ArenaAST& arena, TipoNo tipo, Nome valor, int linha) {
+    return new (arena.alocar(sizeof(ASTNode), alignof(ASTNode))) ASTNode{tipo, TipoDado::INDEFINIDO, linha, valor, {}};
+}
+
+#endif
@@ -0,0 +1,994 @@
+#ifndef SINTATICO_H
+#define SINTATICO_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <set>
+#include <sstream>
+#include <initializer_list>
+
+#include "../Lexico/Lexico.h"
+#include "AST.h"
+
+using namespace std;
+
+// Erro encontrado pela análise, já formatado para exibição.
+struct Diagnostico {
+    int linha;       // Linha do erro (-1 quando está no final do arquivo).
+    string mensagem;
+};
+
+constexpr size_t MAX_ERROS_SINTATICOS = 100; // A análise para depois de tantos erros.
+
+// Lançado por syntaxError(): desvia para o ponto de recuperação (sincronização) mais próximo.
+struct ErroSintatico {};
+
+// Lançado quando MAX_ERROS_SINTATICOS é atingido.
+struct LimiteDeErros {};
+
+// Partes de nível mais externo de um programa: o cabeçalho com as declarações globais,
+// cada função ou procedimento do bloco principal e os comandos do bloco principal.
+enum class TipoRegiao : uint8_t { CABECALHO, SUBROTINA, PRINCIPAL };
+
+struct Regiao {
+    TipoRegiao tipo;
+    size_t primeiroToken;      // Índice em AnalisadorSintatico::tokens onde a região começa
+    size_t primeiraDeclaracao; // Índice em AnalisadorSintatico::declaracoes da primeira declaração da região
+    ASTNode* no;               // Programa (cabeçalho), função/procedimento ou lista de comandos
+};
+
+// Nome registrado na tabela do parser ("rotulo" para os rótulos declarados).
+struct DeclaracaoSintatica {
+    string nome;
+    string categoria;
+    string anterior = ""; // Categoria que o nome tinha antes deste registro ("" se nenhuma)
+};
+
+// Imprime os diagnósticos, um por linha.
+inline void imprimirDiagnosticos(ostream& saida, const vector<Diagnostico>& lista) {
+    for (const Diagnostico& d : lista) {
+        saida << d.mensagem << "\n";
+    }
+}
+
+// Analisador sintático de uma unidade de compilação (um arquivo fonte).
+// Todo o estado da análise fica no objeto, então unidades diferentes podem ser analisadas
+// ao mesmo tempo em threads diferentes. A AST devolvida por programa() vive na arena do
+// analisador e vale enquanto ele existir (ou até o próximo carregarTokens()).
+class AnalisadorSintatico {
+public:
+    vector<Token> tokens; // Armazena tokens lidos.
+    int pos = 0;   // Posição atual no vetor de tokens.
+    set<string> declaredLabels; // Armazena rótulos declarados.
+    map<string, string> TabelaSimbolos; // Tabela de Símbolos: mapeia identificadores para seus tipos.
+    vector<Diagnostico> diagnosticos; // Erros sintáticos da unidade.
+    vector<Regiao> regioes;           // Declarações de nível mais externo, na ordem do fonte.
+    vector<DeclaracaoSintatica> declaracoes; // Tudo o que foi registrado em TabelaSimbolos e declaredLabels, em ordem.
+    ArenaAST arena;       // Memória dos nós da AST da unidade.
+    TabelaDeNomes nomes;  // Textos internados usados como valor dos nós.
+
+    AnalisadorSintatico() = default;
+    explicit AnalisadorSintatico(vector<Token> lista) {
+        carregarTokens(move(lista));
+    }
+
+    // Prepara a lista de tokens para o parser: "read" e "write" são tratados como identificadores.
+    void carregarTokens(vector<Token> lista) {
+        tokens.clear();
+        pos = 0;
+        declaredLabels.clear();
+        TabelaSimbolos.clear();
+        diagnosticos.clear();
+        regioes.clear();
+        declaracoes.clear();
+        arena.limpar();
+        nomes.limpar();
+        acrescentarTokens(move(lista));
+    }
+
+    // Acrescenta tokens ao fim da lista sem perder o estado da análise.
+    void acrescentarTokens(vector<Token> lista) {
+        for (Token& t : lista) {
+            if (t.lexema == "read" || t.lexema == "write") { // Reclassifica "read"/"write".
+                t.tipo = "Identificador";
+            }
+        }
+        if (tokens.empty()) {
+            tokens = move(lista);
+        } else {
+            tokens.insert(tokens.end(), make_move_iterator(lista.begin()), make_move_iterator(lista.end()));
+        }
+    }
+
+    // Verifica se todos os tokens foram consumidos.
+    bool fimTokens() const {
+        return pos >= (int)tokens.size();
+    }
+
+    // Analisa a regra de produção para 'programa'.
+    // Os erros ficam em 'diagnosticos'; a árvore devolvida contém as partes que puderam ser recuperadas.
+    ASTNode* programa() {
+        try {
+            ASTNode* noPrograma = cabecalhoPrograma();
+            ASTNode* noBloco = noPrograma->filhos[0]; // Bloco principal, já com as declarações.
+            while (atual().lexema == "function" || atual().lexema == "procedure") { // Processa funções/procedimentos.
+                adicionarFilho(noBloco, subrotina());
+            }
+            adicionarFilho(noBloco, corpoPrincipal()); // Analisa os comandos do programa.
+            return noPrograma;
+        } catch (const LimiteDeErros&) {
+            diagnosticos.push_back({-1, "Erro: analise interrompida apos " + to_string(MAX_ERROS_SINTATICOS) + " erros."});
+            return nullptr;
+        }
+    }
+
+    // As três partes de 'programa' abaixo também podem ser chamadas uma a uma, cada uma sobre o
+    // trecho de tokens de uma região (ver Compilador/Incremental.h). Cada chamada registra a sua
+    // região em 'regioes'.
+
+    // Cabeçalho do programa e declarações globais (rótulos, tipos e variáveis).
+    // Devolve o nó do programa com o bloco principal ainda sem sub-rotinas e comandos.
+    ASTNode* cabecalhoPrograma() {
+        marcarRegiao(TipoRegiao::CABECALHO);
+        string nomePrograma; // Nome do programa.
+        int linhaPrograma = fimTokens() ? 1 : atual().linha;
+        try {
+            Token progToken = expect("Program"); // Espera "Program".
+            if (progToken.lexema.empty()) {
+                syntaxError("um programa deve comecar com a palavra-chave 'Program'");
+            }
+            Token idToken = expect("Identificador", true); // Espera o nome do programa.
+            if (idToken.lexema.empty()) {
+                syntaxError("esperado um nome de identificador para o programa");
+            }
+            nomePrograma = idToken.lexema; // Armazena o nome.
+
+            if (atual().lexema == "(") { // Se houver parênteses para parâmetros.
+                pos++; // Consome '('.
+                while (atual().lexema != ")" && !fimTokens()) { // Processa identificadores e vírgulas.
+                    if(expect("Identificador", true).lexema.empty()) {
+                        syntaxError("esperado identificador na lista de parametros do programa");
+                    }
+                    if(atual().lexema == ",") pos++; // Consome a vírgula.
+                }
+                if (expect(")").lexema.empty()) { // Espera ')'.
+                    syntaxError("esperado ')' para fechar a lista de parametros do programa");
+                }
+            }
+
+            if (expect(";").lexema.empty()) { // Espera ';'.
+                syntaxError("esperado ';' apos o cabecalho do programa");
+            }
+        } catch (const ErroSintatico&) {
+            // Cabeçalho inválido: segue a partir das declarações ou do bloco principal.
+            sincronizar({";", "label", "type", "var", "function", "procedure", "begin"});
+            expect(";");
+        }
+
+        ASTNode* noPrograma = novoNo(TipoNo::PROGRAMA, nomePrograma, linhaPrograma); // Cria o nó AST do programa.
+        ASTNode* noBloco = novoNo(TipoNo::BLOCO, atual().linha); // Bloco principal.
+        declaracoesDoBloco(noBloco);
+        adicionarFilho(noPrograma, noBloco); // Adiciona o bloco como filho.
+        regioes.back().no = noPrograma;
+        return noPrograma;
+    }
+
+    // Função ou procedimento declarado no bloco principal.
+    ASTNode* subrotina() {
+        marcarRegiao(TipoRegiao::SUBROTINA);
+        ASTNode* noSubRotina = atual().lexema == "function" ? declaracao_funcao() : declaracao_procedimento();
+        regioes.back().no = noSubRotina;
+        return noSubRotina;
+    }
+
+    // Comandos do bloco principal, de 'begin' até o '.' final.
+    ASTNode* corpoPrincipal() {
+        marcarRegiao(TipoRegiao::PRINCIPAL);
+        if (expect("begin").lexema.empty()) { // Espera "begin".
+            registrarErro("esperado 'begin' para iniciar o bloco de comandos"); // Segue como se o 'begin' estivesse lá.
+        }
+        ASTNode* noComandos = lista_comandos(); // Analisa a lista de comandos.
+        if (expect("end").lexema.empty()) { // Espera "end".
+            registrarErro("esperado 'end' para finalizar o bloco");
+        }
+
+        if (expect(".").lexema.empty()) { // Espera '.'.
+            registrarErro("esperado '.'");
+        }
+        if (atual().tipo != "FIM_DE_ARQUIVO" && !fimTokens()) { // Verifica tokens extras no fim, com ou sem o '.'.
+            registrarErro("tokens inesperados '" + atual().lexema + "' apos o final do programa");
+        }
+        regioes.back().no = noComandos;
+        return noComandos;
+    }
+
+    // Reaplica uma declaração registrada por outra análise, como se a região que a contém
+    // tivesse acabado de ser analisada (a declaração não volta para 'declaracoes').
+    void aplicarDeclaracao(const DeclaracaoSintatica& d) {
+        if (d.categoria == "rotulo") {
+            declaredLabels.insert(d.nome);
+        } else {
+            TabelaSimbolos[d.nome] = d.categoria;
+        }
+    }
+
+    // Imprime a Árvore Sintática Abstrata (AST) hierarquicamente.
+    void imprimirAST(ASTNode* node, int nivel = 0) const {
+        if (!node) return; // Se o nó é nulo, retorna.
+        for (int i = 0; i < nivel; ++i) cout << "   "; // Imprime indentação.
+        cout << "+--" << nomeTipoNo(node->tipo); // Imprime o tipo do nó.
+        if (node->valor) cout << " (" << nomes.texto(node->valor) << ")"; // Imprime o valor do nó.
+        if (node->tipoDado != TipoDado::INDEFINIDO) cout << " : " << nomeTipoDado(node->tipoDado); // Tipo calculado, se houver.
+        cout << "\n"; // Quebra de linha.
+        for (ASTNode* filho : node->filhos) { // Para cada filho, chama a função recursivamente.
+            imprimirAST(filho, nivel + 1);
+        }
+    }
+
+private:
+    // Cria um nó da AST na arena do parser.
+    ASTNode* novoNo(TipoNo tipo, const string& valor, int linha) {
+        return criarNo(arena, tipo, nomes.internar(valor), linha);
+    }
+
+    ASTNode* novoNo(TipoNo tipo, int linha) {
+        return criarNo(arena, tipo, 0, linha);
+    }
+
+    // Acrescenta um filho ao nó, no vetor contíguo de filhos.
+    void adicionarFilho(ASTNode* pai, ASTNode* filho) {
+        pai->filhos.adicionar(filho, arena);
+    }
+
+    // Abre uma região de nível mais externo na posição atual.
+    void marcarRegiao(TipoRegiao tipo) {
+        regioes.push_back({tipo, (size_t)pos, declaracoes.size(), nullptr});
+    }
+
+    // Registra um nome na tabela do parser.
+    void registrarNome(const string& nome, const char* categoria) {
+        string& registrada = TabelaSimbolos[nome];
+        declaracoes.push_back({nome, categoria, registrada});
+        registrada = categoria;
+    }
+
+    // Categoria com que o nome foi registrado (vazia se não foi). Não altera a tabela.
+    const string& categoriaRegistrada(const string& nome) const {
+        static const string NENHUMA;
+        auto it = TabelaSimbolos.find(nome);
+        return it == TabelaSimbolos.end() ? NENHUMA : it->second;
+    }
+
+    // Registra um rótulo declarado.
+    void registrarRotulo(const string& rotulo) {
+        bool novo = declaredLabels.insert(rotulo).second;
+        declaracoes.push_back({rotulo, "rotulo", novo ? "" : "rotulo"});
+    }
+
+    // Retorna o token atual.
+    const Token& atual() const {
+        static const Token FIM = {"", "FIM_DE_ARQUIVO", -1};
+        if (pos < (int)tokens.size()) return tokens[pos];
+        return FIM;
+    }
+
+    // Registra um erro sintático na posição atual sem interromper a regra em andamento.
+    void registrarErro(const string& mensagem) {
+        ostringstream texto;
+        if (!fimTokens()) { // Se o erro não é no final do arquivo.
+            texto << "Erro na linha " << atual().linha << ": " << mensagem << ". Token encontrado: '" << atual().lexema << "' do tipo '" << atual().tipo << "'";
+        } else { // Se o erro é no final do arquivo.
+            texto << "Erro: " << mensagem << " no final do arquivo.";
+        }
+        diagnosticos.push_back({fimTokens() ? -1 : atual().linha, texto.str()});
+        if (diagnosticos.size() >= MAX_ERROS_SINTATICOS) throw LimiteDeErros(); // Limita o custo de entradas muito quebradas.
+    }
+
+    // Registra um erro sintático e desvia a análise para o ponto de recuperação mais próximo.
+    ASTNode* syntaxError(const string& mensagem) {
+        registrarErro(mensagem);
+        throw ErroSintatico();
+    }
+
+    // Modo pânico: descarta tokens até um dos lexemas de sincronização (ou o fim dos tokens).
+    void sincronizar(initializer_list<const char*> conjunto) {
+        while (!fimTokens()) {
+            for (const char* lexema : conjunto) {
+                if (atual().lexema == lexema) return;
+            }
+            pos++; // Descarta o token.
+        }
+    }
+
+    // Verifica se o token atual pode iniciar um tipo predefinido.
+    bool iniciaTipo() const {
+        const string& lex = atual().lexema;
+        return lex == "integer" || lex == "boolean" || lex == "string" || lex == "real" || lex == "array";
+    }
+
+    // Verifica se o token atual pode iniciar um comando.
+    bool iniciaComando() const {
+        const string& lex = atual().lexema;
+        return atual().tipo == "Identificador" || lex == "begin" || lex == "if" || lex == "while" || lex == "for" || lex == "goto"
+            || (atual().tipo == "Numero" && static_cast<size_t>(pos) + 1 < tokens.size() && tokens[pos + 1].lexema == ":");
+    }
+
+    // Consome o token atual se corresponder ao esperado.
+    const Token& expect(const string& esperado, bool isType = false) {
+        static const Token NENHUM = {"", "", -1};
+        if (fimTokens()) return NENHUM; // Nada a esperar no fim.
+        if (isType) { // Compara pelo tipo.
+            if (atual().tipo == esperado) {
+                return tokens[pos++]; // Retorna token e avança.
+            }
+        } else { // Compara pelo lexema.
+            if (atual().lexema == esperado) {
+                return tokens[pos++]; // Retorna token e avança.
+            }
+        }
+        return NENHUM; // Não encontrou o token.
+    }
+
+    // Declarações de rótulos, tipos e variáveis no início de um bloco.
+    void declaracoesDoBloco(ASTNode* noBloco) {
+        if (atual().lexema == "label") { // Se há declaração de rótulos.
+            adicionarFilho(noBloco, declaracao_rotulos());
+        }
+        if (atual().lexema == "type") { // Se há declaração de tipos.
+            adicionarFilho(noBloco, declaracao_tipos());
+        }
+        if (atual().lexema == "var") { // Se há declaração de variáveis.
+            adicionarFilho(noBloco, declaracao_variaveis());
+        }
+    }
+
+    // Analisa a regra de produção para 'bloco'.
+    ASTNode* bloco() {
+        ASTNode* noBloco = novoNo(TipoNo::BLOCO, atual().linha); // Cria o nó AST para o bloco.
+        declaracoesDoBloco(noBloco);
+        while (atual().lexema == "function" || atual().lexema == "procedure") { // Processa funções/procedimentos.
+            ASTNode* noSubRotina = nullptr;
+            if (atual().lexema == "function") {
+                noSubRotina = declaracao_funcao(); // Analisa função.
+            } else {
+                noSubRotina = declaracao_procedimento(); // Analisa procedimento.
+            }
+            adicionarFilho(noBloco, noSubRotina); // Adiciona a sub-rotina.
+        }
+        if (expect("begin").lexema.empty()) { // Espera "begin".
+            registrarErro("esperado 'begin' para iniciar o bloco de comandos"); // Segue como se o 'begin' estivesse lá.
+        }
+        adicionarFilho(noBloco, lista_comandos()); // Analisa a lista de comandos.
+
+        if (expect("end").lexema.empty()) { // Espera "end".
+            registrarErro("esperado 'end' para finalizar o bloco");
+        }
+        return noBloco;
+    }
+
+    // Analisa a regra de produção para 'declaracao_rotulos'.
+    ASTNode* declaracao_rotulos() {
+        Token labelToken = expect("label"); // Consome "label".
+        ASTNode* node = novoNo(TipoNo::DECLARACAO_ROTULOS, labelToken.linha); // Cria o nó.
+        try {
+            do {
+                Token numToken = expect("Numero", true); // Espera um número de rótulo.
+                if (numToken.lexema.empty()) syntaxError("esperado um numero de rotulo na declaracao 'label'");
+                registrarRotulo(numToken.lexema); // Insere o rótulo no conjunto.
+                adicionarFilho(node, novoNo(TipoNo::ROTULO, numToken.lexema, numToken.linha)); // Adiciona o nó do rótulo.
+                if (atual().lexema != ",") break; // Sai se não houver vírgula.
+                pos++; // Consome a vírgula.
+            } while (true);
+            if (expect(";").lexema.empty()) syntaxError("esperado ';' para finalizar a declaracao de rotulos"); // Espera ';'.
+        } catch (const ErroSintatico&) {
+            sincronizar({";", "type", "var", "function", "procedure", "begin"}); // Pula o resto da declaração.
+            expect(";");
+        }
+        return node;
+    }
+
+    // Analisa a regra de produção para 'declaracao_tipos'.
+    ASTNode* declaracao_tipos() {
+        Token typeToken = expect("type"); // Consome "type".
+        ASTNode* node = novoNo(TipoNo::DECLARACAO_TIPOS, typeToken.linha); // Cria o nó.
+        while (atual().tipo == "Identificador") { // Processa declarações de tipo.
+            try {
+                Token idToken = expect("Identificador", true); // Espera identificador.
+                registrarNome(idToken.lexema, "tipo"); // Registra o tipo.
+                if (expect("=").lexema.empty()) syntaxError("esperado '=' na declaracao de tipo"); // Espera '='.
+                ASTNode* noTipo = tipo(); // Analisa o tipo.
+                ASTNode* declTipo = novoNo(TipoNo::DECLARACAO_TIPO, idToken.lexema, idToken.linha); // Cria o nó de declaração.
+                adicionarFilho(declTipo, noTipo); // Adiciona o tipo como filho.
+                if (expect(";").lexema.empty()) syntaxError("esperado ';' apos cada declaracao de tipo"); // Espera ';'.
+                adicionarFilho(node, declTipo);   // Adiciona ao nó pai.
+            } catch (const ErroSintatico&) {
+                sincronizar({";", "var", "function", "procedure", "begin"}); // Pula o resto da declaração.
+                expect(";");
+            }
+        }
+        return node;
+    }
+
+    // Analisa a regra de produção para 'declaracao_variaveis'.
+    ASTNode* declaracao_variaveis() {
+        Token varToken = expect("var"); // Consome "var".
+        ASTNode* noVars = novoNo(TipoNo::DECLARACAO_VARIAVEIS, varToken.linha); // Cria o nó.
+        while (atual().tipo == "Identificador") { // Processa grupos de variáveis.
+            try {
+                ASTNode* noLista = lista_identificadores(); // Analisa a lista de identificadores.
+                for(auto& filho : noLista->filhos) { // Registra cada variável.
+                    registrarNome(nomes.texto(filho->valor), "variavel");
+                }
+                if (expect(":").lexema.empty()) { // Espera ':'.
+                    if (!iniciaTipo()) syntaxError("esperado ':' entre os nomes das variaveis e o seu tipo");
+                    registrarErro("esperado ':' entre os nomes das variaveis e o seu tipo"); // Segue como se o ':' estivesse lá.
+                }
+                ASTNode* noTipo = tipo(); // Analisa o tipo.
+                if (expect(";").lexema.empty()) syntaxError("esperado ';' ao final da declaracao de variavel"); // Espera ';'.
+                ASTNode* noDecl = novoNo(TipoNo::DECLARACAO_VARIAVEL, noLista->linha); // Cria o nó de declaração.
+                adicionarFilho(noDecl, noLista); // Adiciona a lista de identificadores.
+                adicionarFilho(noDecl, noTipo);  // Adiciona o tipo.
+                adicionarFilho(noVars, noDecl);  // Adiciona ao nó pai.
+            } catch (const ErroSintatico&) {
+                sincronizar({";", "function", "procedure", "begin"}); // Pula o resto da declaração.
+                expect(";");
+            }
+        }
+        return noVars;
+    }
+
+    // Analisa a regra de produção para 'lista_identificadores'.
+    ASTNode* lista_identificadores() {
+        ASTNode* noLista = novoNo(TipoNo::LISTA_IDENTIFICADORES, atual().linha); // Cria o nó.
+        do {
+            Token idToken = expect("Identificador", true); // Espera um identificador.
+            if (idToken.lexema.empty()) return syntaxError("esperado um identificador na lista");
+            adicionarFilho(noLista, novoNo(TipoNo::IDENTIFICADOR, idToken.lexema, idToken.linha)); // Adiciona o nó do identificador.
+            if (atual().lexema != ",") break; // Sai se não houver vírgula.
+            pos++; // Consome a vírgula.
+        } while (true);
+        return noLista;
+    }
+
+    // Analisa a regra de produção para 'tipo'.
+    ASTNode* tipo() {
+        string lex = atual().lexema; // Pega o lexema.
+        int linhaTipo = atual().linha; // Linha do tipo.
+        if (lex == "integer" || lex == "boolean" || lex == "string" || lex == "real" || lex == "numero") { // Tipos primitivos.
+            pos++; // Consome o token.
+            return novoNo(TipoNo::TIPO_PRIMITIVO, lex, linhaTipo); // Retorna o nó do tipo primitivo.
+        }
+        if (lex == "array") { // Se é um array.
+            pos++; // Consome "array".
+            ASTNode* noArray = novoNo(TipoNo::TIPO_ARRAY, linhaTipo); // Cria o nó do array.
+            if (expect("[").lexema.empty()) return syntaxError("esperado '[' apos a palavra 'array'"); // Espera '['.
+
+            Token inicio = expect("Numero", true); // Espera índice inicial.
+            if(inicio.lexema.empty()) return syntaxError("esperado numero para indice inicial do array");
+            adicionarFilho(noArray, novoNo(TipoNo::NUMERO, inicio.lexema, inicio.linha)); // Adiciona o índice.
+
+            if (expect("..").lexema.empty()) return syntaxError("esperado '..' para separar os indices do array"); // Espera "..".
+
+            Token fim = expect("Numero", true); // Espera índice final.
+            if(fim.lexema.empty()) return syntaxError("esperado numero para indice final do array");
+            adicionarFilho(noArray, novoNo(TipoNo::NUMERO, fim.lexema, fim.linha)); // Adiciona o índice.
+
+            if (expect("]").lexema.empty()) return syntaxError("esperado ']' apos os indices do array"); // Espera ']'.
+            if (expect("of").lexema.empty()) return syntaxError("esperado 'of' na declaracao do array"); // Espera "of".
+            ASTNode* tipoElem = tipo(); // Analisa o tipo dos elementos do array.
+            if (!tipoElem) return nullptr;
+            adicionarFilho(noArray, tipoElem); // Adiciona o tipo do elemento.
+            return noArray;
+        }
+        if(atual().tipo == "Identificador") { // Se é um tipo definido pelo usuário.
+            string idTipo = atual().lexema;
+            pos++; // Consome o identificador.
+            return novoNo(TipoNo::TIPO_IDENTIFICADOR, idTipo, linhaTipo); // Retorna o nó do tipo identificador.
+        }
+        return syntaxError("esperado um tipo valido"); // Tipo inválido.
+    }
+
+    // Analisa a regra de produção para 'declaracao_funcao'.
+    ASTNode* declaracao_funcao() {
+        Token funcToken = expect("function"); // Consome "function".
+        ASTNode* noFunc = nullptr; // Nó da função.
+        ASTNode* noParams = nullptr; // Inicializa parâmetros.
+        ASTNode* noTipoRet = nullptr; // Tipo de retorno.
+        try {
+            Token idToken = expect("Identificador", true); // Espera o nome da função.
+            if (idToken.lexema.empty()) syntaxError("esperado um nome de identificador para a funcao");
+            registrarNome(idToken.lexema, "funcao"); // Registra como função.
+            noFunc = novoNo(TipoNo::FUNCAO, idToken.lexema, idToken.linha); // Cria o nó da função.
+            if (atual().lexema == "(") { // Se há parâmetros.
+                pos++; // Consome '('.
+                if (atual().lexema != ")") noParams = parametros(); // Analisa parâmetros.
+                if (expect(")").lexema.empty()) syntaxError("esperado ')' para fechar a lista de parametros"); // Espera ')'.
+            }
+            if (expect(":").lexema.empty()) syntaxError("esperado ':' antes do tipo de retorno da funcao"); // Espera ':'.
+            noTipoRet = tipo(); // Analisa o tipo de retorno.
+            if (expect(";").lexema.empty()) syntaxError("esperado ';' apos a assinatura da funcao"); // Espera ';'.
+        } catch (const ErroSintatico&) {
+            // Assinatura inválida: pula até o corpo e analisa o bloco assim mesmo.
+            sincronizar({";", "label", "type", "var", "function", "procedure", "begin"});
+            expect(";");
+        }
+        ASTNode* noBloco = bloco(); // Analisa o bloco da função.
+        if (expect(";").lexema.empty()) registrarErro("esperado ';' apos o 'end' do bloco da funcao"); // Espera ';'.
+
+        if (!noFunc) noFunc = novoNo(TipoNo::FUNCAO, funcToken.linha); // Função sem nome válido.
+        adicionarFilho(noFunc, noParams ? noParams : novoNo(TipoNo::PARAMETROS_VAZIOS, noFunc->linha)); // Adiciona parâmetros.
+        adicionarFilho(noFunc, noTipoRet ? noTipoRet : novoNo(TipoNo::TIPO_PRIMITIVO, noFunc->linha)); // Adiciona tipo de retorno.
+        adicionarFilho(noFunc, noBloco); // Adiciona o bloco.
+        return noFunc;
+    }
+
+    // Analisa a regra de produção para 'declaracao_procedimento'.
+    ASTNode* declaracao_procedimento() {
+        Token procToken = expect("procedure"); // Consome "procedure".
+        ASTNode* noProc = nullptr; // Nó do procedimento.
+        ASTNode* noParams = nullptr; // Inicializa parâmetros.
+        try {
+            Token idToken = expect("Identificador", true); // Espera o nome do procedimento.
+            if (idToken.lexema.empty()) syntaxError("esperado um nome de identificador para o procedimento");
+            registrarNome(idToken.lexema, "procedimento"); // Registra como procedimento.
+            noProc = novoNo(TipoNo::PROCEDIMENTO, idToken.lexema, idToken.linha); // Cria o nó do procedimento.
+            if (atual().lexema == "(") { // Se há parâmetros.
+                pos++; // Consome '('.
+                if (atual().lexema != ")") noParams = parametros(); // Analisa parâmetros.
+                if (expect(")").lexema.empty()) syntaxError("esperado ')' para fechar a lista de parametros"); // Espera ')'.
+            }
+            if (expect(";").lexema.empty()) syntaxError("esperado ';' apos a assinatura do procedimento"); // Espera ';'.
+        } catch (const ErroSintatico&) {
+            // Assinatura inválida: pula até o corpo e analisa o bloco assim mesmo.
+            sincronizar({";", "label", "type", "var", "function", "procedure", "begin"});
+            expect(";");
+        }
+        ASTNode* noBloco = bloco(); // Analisa o bloco do procedimento.
+        if (expect(";").lexema.empty()) registrarErro("esperado ';' apos o 'end' do bloco do procedimento"); // Espera ';'.
+
+        if (!noProc) noProc = novoNo(TipoNo::PROCEDIMENTO, procToken.linha); // Procedimento sem nome válido.
+        adicionarFilho(noProc, noParams ? noParams : novoNo(TipoNo::PARAMETROS_VAZIOS, noProc->linha)); // Adiciona parâmetros.
+        adicionarFilho(noProc, noBloco); // Adiciona o bloco.
+        return noProc;
+    }
+
+    // Analisa a regra de produção para 'parametros'.
+    ASTNode* parametros() {
+        ASTNode* noLista = novoNo(TipoNo::LISTA_PARAMETROS, atual().linha); // Cria o nó.
+        do {
+            bool porReferencia = !expect("var").lexema.empty(); // Verifica se é por referência.
+            ASTNode* idLista = lista_identificadores(); // Analisa a lista de identificadores.
+            if(!idLista) return nullptr;
+            if(expect(":").lexema.empty()) { // Espera ':'.
+                if (!iniciaTipo()) return syntaxError("esperado ':' na declaracao de parametro");
+                registrarErro("esperado ':' na declaracao de parametro"); // Segue como se o ':' estivesse lá.
+            }
+            ASTNode* tipoParam = tipo(); // Analisa o tipo do parâmetro.
+            if(!tipoParam) return nullptr;
+            ASTNode* paramGroup = novoNo(porReferencia ? TipoNo::GRUPO_PARAMETRO_REF : TipoNo::GRUPO_PARAMETRO_VALOR, idLista->linha); // Cria o grupo de parâmetros.
+            adicionarFilho(paramGroup, idLista);  // Adiciona a lista de identificadores.
+            adicionarFilho(paramGroup, tipoParam); // Adiciona o tipo.
+            adicionarFilho(noLista, paramGroup); // Adiciona o grupo à lista.
+
+            if (atual().lexema != ";") break; // Sai se não houver ';'.
+            pos++; // Consome ';'.
+        } while (true);
+        return noLista;
+    }
+
+    // Analisa a regra de produção para 'lista_comandos'.
+    // Só 'end' (ou o fim do arquivo) termina a lista: um 'else' solto é relatado onde aparece e a
+    // análise segue no comando depois dele, sem desfazer as listas que envolvem esta.
+    ASTNode* lista_comandos() {
+        ASTNode* lista = novoNo(TipoNo::LISTA_COMANDOS, atual().linha); // Cria o nó.
+        while (true) {
+            if (atual().lexema == "end" || atual().tipo == "FIM_DE_ARQUIVO" || fimTokens()) { // Condições de parada.
+                break;
+            }
+            if (atual().lexema == "else") { // 'else' sem 'if': o 'if' já terminou (ex.: ';' antes do 'else').
+                registrarErro("'else' sem um 'if' correspondente (um ';' antes do 'else' termina o 'if')");
+                pos++; // Consome o 'else' e analisa o comando seguinte normalmente.
+                continue;
+            }
+
+            try {
+                ASTNode* cmd = comando(); // Analisa um comando.
+                if (!cmd) syntaxError("comando invalido ou inesperado"); // Se o comando é inválido.
+                adicionarFilho(lista, cmd); // Adiciona o comando à lista.
+            } catch (const ErroSintatico&) {
+                sincronizar({";", "end", "else"}); // Modo pânico: descarta o resto do comando.
+                if (atual().lexema == "else") { // O 'else' é do 'if' que tinha o erro: segue pelo comando dele.
+                    pos++;
+                    continue;
+                }
+            }
+
+            if (atual().lexema == ";") { // Se há ';'.
+                pos++; // Consome ';'.
+                if (atual().lexema == "end") { // Se for "end" depois do ';'.
+                    break;
+                }
+            } else if (atual().lexema == "end" || atual().tipo == "FIM_DE_ARQUIVO" || fimTokens()) { // Se for terminador.
+                break;
+            } else if (atual().lexema != "else") { // O 'else' solto é relatado no início do laço.
+                registrarErro("esperado ';' apos o comando ou 'end' para terminar o bloco"); // Erro.
+                if (!iniciaComando()) { // Se o próximo comando não começa aqui, descarta até o separador.
+                    sincronizar({";", "end", "else"});
+                    if (atual().lexema == ";") pos++;
+                }
+            }
+        }
+        return lista;
+    }
+
+    // Analisa a regra de produção para 'comando'.
+    ASTNode* comando() {
+        ASTNode* noRotulo = nullptr;
+
+        // Verifica e consome o rótulo (SE HOUVER).
+        if (atual().tipo == "Numero" && static_cast<size_t>(pos) + 1 < tokens.size() && tokens[pos + 1].lexema == ":") {
+            // Verifica se o rótulo foi previamente declarado na seção 'label'.
+            if (declaredLabels.find(atual().lexema) == declaredLabels.end()) {
+                return syntaxError("uso de rotulo '" + atual().lexema + "' que nao foi declarado na secao 'label'");
+            }
+            // Cria um nó na AST para representar o uso deste rótulo.
+            noRotulo = novoNo(TipoNo::ROTULO_USO, atual().lexema, atual().linha);
+            pos += 2; // Consome o token do número (rótulo) e o token ':'.
+        }
+
+        // Analisa o comando real que vem a seguir (o "comando sem rótulo").
+        ASTNode* noComandoReal = nullptr;
+        string lex = atual().lexema;
+
+        if (lex == "begin") {
+            pos++; // Consome "begin".
+            noComandoReal = lista_comandos();
+            if (!noComandoReal) return nullptr;
+            if (expect("end").lexema.empty()) return syntaxError("esperado 'end' apos bloco de comando aninhado");
+        }
+        else if (lex == "if") {
+            pos++; // Consome "if".
+            ASTNode* cond = expressao();
+            if (!cond) return nullptr;
+            if (expect("then").lexema.empty()) return syntaxError("esperado 'then' apos a condicao do 'if'");
+            ASTNode* noThen = comando();
+            if (!noThen) return syntaxError("esperado um comando apos 'then'");
+
+            noComandoReal = novoNo(TipoNo::IF, cond->linha);
+            adicionarFilho(noComandoReal, cond);
+            adicionarFilho(noComandoReal, noThen);
+
+            if (atual().lexema == "else") {
+                pos++; // Consome "else".
+                ASTNode* noElse = comando();
+                if (!noElse) return syntaxError("esperado um comando apos 'else'");
+                adicionarFilho(noComandoReal, noElse);
+            }
+        }
+        else if (lex == "while") {
+            pos++; // Consome "while".
+            ASTNode* cond = expressao();
+            if (!cond) return nullptr;
+            if (expect("do").lexema.empty()) return syntaxError("esperado 'do' apos a condicao do 'while'");
+            ASTNode* noCmd = comando();
+            if (!noCmd) return nullptr;
+
+            noComandoReal = novoNo(TipoNo::WHILE, cond->linha);
+            adicionarFilho(noComandoReal, cond);
+            adicionarFilho(noComandoReal, noCmd);
+        }
+        else if (lex == "for") {
+            pos++; // Consome "for".
+            Token idToken = expect("Identificador", true); // Espera a variável de controle.
+            if (idToken.lexema.empty()) return syntaxError("esperado a variavel de controle do 'for'");
+            if (expect(":=").lexema.empty()) return syntaxError("esperado ':=' apos a variavel de controle do 'for'");
+            ASTNode* inicio = expressao();
+            if (!inicio) return nullptr;
+            string sentido = atual().lexema; // "to" ou "downto".
+            if (sentido != "to" && sentido != "downto") return syntaxError("esperado 'to' ou 'downto' no 'for'");
+            pos++; // Consome "to"/"downto".
+            ASTNode* fim = expressao();
+            if (!fim) return nullptr;
+            if (expect("do").lexema.empty()) return syntaxError("esperado 'do' apos os limites do 'for'");
+            ASTNode* noCmd = comando();
+            if (!noCmd) return syntaxError("esperado um comando apos 'do'");
+
+            noComandoReal = novoNo(TipoNo::FOR, sentido, idToken.linha);
+            adicionarFilho(noComandoReal, novoNo(TipoNo::IDENTIFICADOR, idToken.lexema, idToken.linha));
+            adicionarFilho(noComandoReal, inicio);
+            adicionarFilho(noComandoReal, fim);
+            adicionarFilho(noComandoReal, noCmd);
+        }
+        else if (lex == "goto") {
+            pos++; // Consome "goto".
+            Token label = expect("Numero", true);
+            if (label.lexema.empty()) return syntaxError("esperado um numero de rotulo para o 'goto'");
+            if (declaredLabels.find(label.lexema) == declaredLabels.end()) {
+                return syntaxError("uso de 'goto' para rotulo nao declarado: '" + label.lexema + "'");
+            }
+            noComandoReal = novoNo(TipoNo::GOTO, label.lexema, label.linha);
+        }
+        else if (atual().tipo == "Identificador") { // Potencialmente uma atribuição ou chamada de procedimento.
+            int backtrack_pos = pos;
+            ASTNode* lhs = variavel();
+
+            if (lhs) {
+                if (atual().lexema == ":=") { // É uma atribuição.
+                    pos++; // Consome ":=".
+                    ASTNode* rhs = expressao();
+                    if (!rhs) return syntaxError("expressao invalida apos ':='");
+
+                    ASTNode* assignNode = novoNo(TipoNo::ATRIBUICAO, lhs->linha);
+                    adicionarFilho(assignNode, lhs);
+                    adicionarFilho(assignNode, rhs);
+
+                    if (lhs->tipo == TipoNo::IDENTIFICADOR && categoriaRegistrada(nomes.texto(lhs->valor)) == "funcao") {
+                        assignNode->tipo = TipoNo::RETORNO_FUNCAO;
+                    }
+                    noComandoReal = assignNode;
+                } else { // Não é atribuição, deve ser uma chamada de procedimento.
+                    pos = backtrack_pos; // O nó descartado fica na arena até o fim da unidade.
+                    noComandoReal = chamada_subrotina();
+                }
+            }
+        }
+
+        // Combina o resultado.
+        if (noRotulo) {
+            // Se encontrado um rótulo, ele deve ser seguido por um comando válido.
+            if (!noComandoReal) {
+                return syntaxError("esperado um comando valido apos o rotulo '" + nomes.texto(noRotulo->valor) + ":'");
+            }
+            // Cria um nó pai para agrupar o rótulo e o comando.
+            ASTNode* comandoComRotulo = novoNo(TipoNo::COMANDO_COM_ROTULO, noRotulo->linha);
+            adicionarFilho(comandoComRotulo, noRotulo);
+            adicionarFilho(comandoComRotulo, noComandoReal);
+            return comandoComRotulo;
+        } else {
+            // Se não havia rótulo, retorna apenas o comando que foi analisado (ou nullptr se for inválido).
+            return noComandoReal;
+        }
+    }
+
+    // Analisa a regra de produção para 'variavel'.
+    ASTNode* variavel() {
+        if (atual().tipo != "Identificador") { // Se não é identificador.
+            return nullptr;
+        }
+        Token idToken = tokens[pos]; // Pega o identificador.
+        pos++; // Consome o identificador.
+
+        ASTNode* varNode = novoNo(TipoNo::IDENTIFICADOR, idToken.lexema, idToken.linha); // Cria o nó do identificador.
+
+        if (atual().lexema == "[") { // Se é acesso a array.
+            pos++; // Consome '['.
+            ASTNode* indexExpr = expressao(); // Analisa a expressão do índice.
+            if (!indexExpr) return syntaxError("expressao de indice de array invalida");
+            if (expect("]").lexema.empty()) return syntaxError("esperado ']' para fechar o indice do array"); // Espera ']'.
+
+            ASTNode* accessNode = novoNo(TipoNo::ACESSO_ARRAY, idToken.lexema, idToken.linha); // Cria o nó de acesso a array.
+            adicionarFilho(accessNode, varNode); // O filho é o nome do array.
+            adicionarFilho(accessNode, indexExpr); // O outro filho é a expressão do índice.
+            return accessNode;
+        }
+
+        return varNode; // Retorna o nó do identificador.
+    }
+
+    // Analisa a regra de produção para 'expressao' (lógica OR).
+    ASTNode* expressao() {
+        ASTNode* noEsq = termo_logico(); // Analisa o termo lógico esquerdo.
+        if (!noEsq) return nullptr;
+        while (atual().lexema == "or") { // Enquanto houver "or".
+            string op = atual().lexema; // Pega o operador.
+            pos++; // Consome "or".
+            ASTNode* noDir = termo_logico(); // Analisa o termo lógico direito.
+            if (!noDir) return syntaxError("esperado expressao apos operador '" + op + "'");
+            ASTNode* noExp = novoNo(TipoNo::OPERADOR_BINARIO, op, noEsq->linha); // Cria o nó do operador binário.
+            adicionarFilho(noExp, noEsq); // Adiciona o lado esquerdo.
+            adicionarFilho(noExp, noDir); // Adiciona o lado direito.
+            noEsq = noExp; // Atualiza o lado esquerdo.
+        }
+        return noEsq;
+    }
+
+    // Analisa a regra de produção para 'termo_logico' (lógica AND).
+    ASTNode* termo_logico() {
+        ASTNode* noEsq = expressao_relacional(); // Analisa a expressão relacional esquerda.
+        if (!noEsq) return nullptr;
+        while (atual().lexema == "and") { // Enquanto houver "and".
+            string op = atual().lexema; // Pega o operador.
+            pos++; // Consome "and".
+            ASTNode* noDir = expressao_relacional(); // Analisa a expressão relacional direita.
+            if (!noDir) return syntaxError("esperado expressao apos operador '" + op + "'");
+            ASTNode* noExp = novoNo(TipoNo::OPERADOR_BINARIO, op, noEsq->linha); // Cria o nó do operador binário.
+            adicionarFilho(noExp, noEsq); // Adiciona o lado esquerdo.
+            adicionarFilho(noExp, noDir); // Adiciona o lado direito.
+            noEsq = noExp; // Atualiza o lado esquerdo.
+        }
+        return noEsq;
+    }
+
+    // Analisa a regra de produção para 'expressao_relacional'.
+    ASTNode* expressao_relacional() {
+        ASTNode* noEsq = expressao_aritmetica(); // Analisa a expressão aritmética esquerda.
+        if (!noEsq) return nullptr;
+        static const set<string> operadoresRelacionais = {"=", "<>", "<", "<=", ">", ">="}; // Define operadores relacionais.
+        if (operadoresRelacionais.count(atual().lexema)) { // Se o token atual é um operador relacional.
+            string op = atual().lexema; // Pega o operador.
+            pos++; // Consome o operador.
+            ASTNode* noDir = expressao_aritmetica(); // Analisa a expressão aritmética direita.
+            if (!noDir) return syntaxError("esperado expressao apos operador relacional '" + op + "'");
+            ASTNode* noExp = novoNo(TipoNo::OPERADOR_BINARIO, op, noEsq->linha); // Cria o nó do operador binário.
+            adicionarFilho(noExp, noEsq); // Adiciona o lado esquerdo.
+            adicionarFilho(noExp, noDir); // Adiciona o lado direito.
+            return noExp;
+        }
+        return noEsq;
+    }
+
+    // Analisa a regra de produção para 'expressao_aritmetica'.
+    ASTNode* expressao_aritmetica() {
+        ASTNode* noEsq = nullptr; // Inicializa o lado esquerdo.
+        string op_unario = ""; // Inicializa o operador unário.
+        if (atual().lexema == "+" || atual().lexema == "-") { // Se há operador unário.
+            op_unario = atual().lexema; // Pega o operador.
+            pos++; // Consome o operador.
+        }
+        noEsq = termo_aritmetico(); // Analisa o termo aritmético.
+        if (!noEsq) return nullptr;
+        if (!op_unario.empty()) { // Se havia operador unário.
+            ASTNode* noUnario = novoNo(TipoNo::OPERADOR_UNARIO, op_unario, noEsq->linha); // Cria o nó do operador unário.
+            adicionarFilho(noUnario, noEsq); // Adiciona o operando.
+            noEsq = noUnario; // Atualiza o lado esquerdo.
+        }
+
+        while (atual().lexema == "+" || atual().lexema == "-") { // Enquanto houver adição/subtração.
+            string op = atual().lexema; // Pega o operador.
+            pos++; // Consome o operador.
+            ASTNode* noDir = termo_aritmetico(); // Analisa o termo aritmético direito.
+            if (!noDir) return syntaxError("esperado termo apos operador '" + op + "'");
+            ASTNode* noExp = novoNo(TipoNo::OPERADOR_BINARIO, op, noEsq->linha); // Cria o nó do operador binário.
+            adicionarFilho(noExp, noEsq); // Adiciona o lado esquerdo.
+            adicionarFilho(noExp, noDir); // Adiciona o lado direito.
+            noEsq = noExp; // Atualiza o lado esquerdo.
+        }
+        return noEsq;
+    }
+
+    // Analisa a regra de produção para 'termo_aritmetico'.
+    ASTNode* termo_aritmetico() {
+        ASTNode* noEsq = fator(); // Analisa o fator esquerdo.
+        if (!noEsq) return nullptr;
+        while (atual().lexema == "*" || atual().lexema == "/" || atual().lexema == "div" || atual().lexema == "mod") { // Enquanto houver multiplicação/divisão.
+            string op = atual().lexema; // Pega o operador.
+            pos++; // Consome o operador.
+            ASTNode* noDir = fator(); // Analisa o fator direito.
+            if (!noDir) return syntaxError("esperado fator apos operador '" + op + "'");
+            ASTNode* noExp = novoNo(TipoNo::OPERADOR_BINARIO, op, noEsq->linha); // Cria o nó do operador binário.
+            adicionarFilho(noExp, noEsq); // Adiciona o lado esquerdo.
+            adicionarFilho(noExp, noDir); // Adiciona o lado direito.
+            noEsq = noExp; // Atualiza o lado esquerdo.
+        }
+        return noEsq;
+    }
+
+    // Analisa a regra de produção para 'fator'.
+    ASTNode* fator() {
+        if (atual().lexema == "not") { // Se for "not".
+            int linhaNot = atual().linha; // Linha do "not".
+            pos++; // Consome "not".
+            ASTNode* noNot = novoNo(TipoNo::OPERADOR_UNARIO, "not", linhaNot); // Cria o nó do operador unário.
+            ASTNode* noFator = fator(); // Analisa o fator.
+            if (!noFator) return syntaxError("esperado uma expressao ou fator apos 'not'");
+            adicionarFilho(noNot, noFator); // Adiciona o operando.
+            return noNot;
+        }
+        if (atual().tipo == "Numero") { // Se for um número.
+            ASTNode* noNum = novoNo(TipoNo::NUMERO, atual().lexema, atual().linha); // Cria o nó do número.
+            pos++; // Consome o número.
+            return noNum;
+        }
+        if (atual().tipo == "String") { // Se for uma string literal.
+            ASTNode* noString = novoNo(TipoNo::STRING, atual().lexema, atual().linha); // Cria o nó da string.
+            pos++; // Consome a string.
+            return noString;
+        }
+        if (atual().tipo == "Identificador") { // Se for um identificador.
+            if (static_cast<size_t>(pos) + 1 < tokens.size() && tokens[pos + 1].lexema == "(") { // Se for chamada de função.
+                string id = atual().lexema; // Pega o identificador.
+                const string& categoria = categoriaRegistrada(id);
+                if (!categoria.empty() && categoria != "funcao" && id != "read" && id != "write") { // Verifica o tipo.
+                    return syntaxError("identificador '" + id + "' e um " + categoria + ", nao uma funcao, e nao pode ser usado em uma expressao");
+                }
+                return chamada_subrotina(); // Analisa a chamada de sub-rotina.
+            } else {
+                return variavel(); // Analisa a variável.
+            }
+        }
+        if (expect("(").lexema.empty() == false) { // Se for parênteses.
+            ASTNode* noExp = expressao(); // Analisa a expressão interna.
+            if (!noExp) return nullptr;
+            if (expect(")").lexema.empty()) { // Espera ')'.
+                return syntaxError("esperado ')' para fechar a expressao entre parenteses");
+            }
+            return noExp;
+        }
+        return syntaxError("fator invalido: esperado numero, string, identificador, 'not', ou expressao com '()'"); // Fator inválido.
+    }
+
+    // Analisa a regra de produção para 'chamada_subrotina'.
+    ASTNode* chamada_subrotina() {
+        Token idToken = expect("Identificador", true); // Espera o identificador da sub-rotina.
+        if(idToken.lexema.empty()) return nullptr;
+
+        ASTNode* noCall = novoNo(TipoNo::CHAMADA_SUBROTINA, idToken.lexema, idToken.linha); // Cria o nó da chamada.
+        if (atual().lexema == "(") { // Se houver argumentos.
+            pos++; // Consome '('.
+            if (atual().lexema != ")") {
+                ASTNode* noArgs = lista_argumentos(); // Analisa a lista de argumentos.
+                if (!noArgs) return nullptr;
+                adicionarFilho(noCall, noArgs); // Adiciona os argumentos.
+            }
+            if (expect(")").lexema.empty()) { // Espera ')'.
+                return syntaxError("esperado ')' para fechar a lista de argumentos da chamada de '" + idToken.lexema + "'");
+            }
+        }
+        return noCall;
+    }
+
+    // Analisa a regra de produção para 'lista_argumentos'.
+    ASTNode* lista_argumentos() {
+        ASTNode* noLista = novoNo(TipoNo::LISTA_ARGUMENTOS, atual().linha); // Cria o nó.
+        do {
+            ASTNode* noExpr = expressao(); // Analisa uma expressão para cada argumento.
+            if (!noExpr) return syntaxError("argumento invalido na lista de argumentos");
+            adicionarFilho(noLista, noExpr); // Adiciona a expressão como filho.
+            if (atual().lexema != ",") break; // Sai se não houver vírgula.
+            pos++; // Consome a vírgula.
+        } while (true);
+        return noLista;
+    }
+};
+
+// Lê a tabela de tokens gerada pelo analisador léxico (formato de saida.txt).
+// Mantido para os programas que ainda leem o arquivo intermediário.
+inline bool lerTokensSaida(istream& arquivo, vector<Token>& lista) {
+    string linha; // Variável para cada linha.
+    if (!getline(arquivo, linha) || !getline(arquivo, linha)) { // Pula cabeçalho.
+        return false;
+    }
+
+    int linhaDoCodigoFonte = 1; // O arquivo não guarda a linha: numera token a token.
+    while (getline(arquivo, linha)) { // Lê cada linha.
+        if (linha.find_first_not_of(" \t\r\n") == string::npos) { // Ignora linhas em branco.
+            continue;
+        }
+
+        stringstream ss(linha); // Cria stringstream.
+        Token t; // Cria um token.
+
+        if (!(ss >> t.lexema)) { // Extrai o lexema.
+            continue; // Pula linha mal formatada.
+        }
+
+        string tipoCompleto; // Extrai o resto como tipo.
+        getline(ss, tipoCompleto);
+
+        size_t first = tipoCompleto.find_first_not_of(" \t"); // Remove espaços do tipo.
+        if (string::npos != first) {
+            size_t last = tipoCompleto.find_last_not_of(" \t\r");
+            t.tipo = tipoTokenCanonico(tipoCompleto.substr(first, (last - first + 1)));
+        } else {
+            t.tipo = "";
+        }
+
+        t.linha = linhaDoCodigoFonte++; // Atribui linha e incrementa.
+        lista.push_back(t); // Adiciona o token.
+    }
+    return true;
+}
+
+#endif